@@ -12,7 +12,8 @@ macro (generate_stdlib_source module_name dest_variable)
       OUTPUT ${DEST_CPP_FILE}
       COMMAND python stdlib_cpp_gen.py ${STDLIB_FILES_TEMPLATE} ${module_name} ${SOURCE_MODULE} ${DEST_CPP_FILE}
       WORKING_DIRECTORY ${CMAKE_SOURCE_DIR}/tools
-      DEPENDS ${SOURCE_MODULE}
+      DEPENDS ${SOURCE_MODULE} ${STDLIB_FILES_TEMPLATE}
+              ${CMAKE_SOURCE_DIR}/tools/stdlib_cpp_gen.py
       COMMENT "Generation ${DEST_CPP_FILE} stdlib file for lispp project"
   )
 
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+
+namespace lispp {
+
+// NOTE: Non-owning view of call arguments: the calling convention of
+//       callables (see CallableObject::execute_impl). Arguments are owned by
+//       the caller: an ArgsBuffer, the interpreter stack or a vector
+class ArgsSpan {
+public:
+  using iterator = const ObjectPtr<>*;
+  using const_iterator = const ObjectPtr<>*;
+
+  ArgsSpan() = default;
+  ArgsSpan(const ObjectPtr<>* data, std::size_t size)
+      : data_(data), size_(size) {}
+  // non-explicit
+  ArgsSpan(const std::vector<ObjectPtr<>>& args)
+      : data_(args.data()), size_(args.size()) {}
+
+  const ObjectPtr<>* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  iterator begin() const { return data_; }
+  iterator end() const { return data_ + size_; }
+
+  const ObjectPtr<>& operator[](std::size_t index) const {
+    assert(index < size_);
+    return data_[index];
+  }
+
+  const ObjectPtr<>& front() const { return (*this)[0]; }
+  const ObjectPtr<>& back() const { return (*this)[size_ - 1]; }
+
+  ArgsSpan subspan(std::size_t offset) const {
+    assert(offset <= size_);
+    return ArgsSpan(data_ + offset, size_ - offset);
+  }
+
+private:
+  const ObjectPtr<>* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// NOTE: Arguments storage of tree-walking calls. Up to kInlineSize
+//       arguments are kept inline (on the C++ stack of the caller)
+class ArgsBuffer {
+public:
+  static constexpr std::size_t kInlineSize = 8;
+
+  ArgsBuffer() = default;
+  ArgsBuffer(const ArgsBuffer&) = delete;
+  ArgsBuffer& operator=(const ArgsBuffer&) = delete;
+
+  void push_back(ObjectPtr<> arg) {
+    if (size_ < kInlineSize) {
+      inline_args_[size_++] = std::move(arg);
+      return;
+    }
+
+    if (size_ == kInlineSize) {
+      heap_args_.reserve(2 * kInlineSize);
+      for (auto& inline_arg : inline_args_) {
+        heap_args_.push_back(std::move(inline_arg));
+      }
+    }
+    heap_args_.push_back(std::move(arg));
+    ++size_;
+  }
+
+  std::size_t size() const { return size_; }
+
+  ArgsSpan get_span() const {
+    return (size_ <= kInlineSize ? ArgsSpan(inline_args_, size_)
+                                 : ArgsSpan(heap_args_));
+  }
+
+private:
+  ObjectPtr<> inline_args_[kInlineSize];
+  std::size_t size_ = 0;
+  std::vector<ObjectPtr<>> heap_args_;
+};
+
+} // lispp
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <lispp/cycle_collector.h>
 #include <lispp/object.h>
 #include <lispp/object_ptr.h>
 
@@ -22,13 +23,18 @@ public:
   BackTickObject* as_back_tick() override { return this; }
   const BackTickObject* as_back_tick() const override { return this; }
 
+  void traverse(ReferenceVisitor& visitor) const override {
+    visitor.visit(value_);
+  }
+  void clear_references() override { value_.reset(); }
+
   bool operator==(const Object& other) const override;
   std::string to_string() const override;
-  ObjectPtr<> eval(const std::shared_ptr<Scope>& scope) override;
+  ObjectPtr<> eval(const ScopePtr& scope) override;
 
 private:
   static ObjectPtr<> process_object_on_eval(ObjectPtr<> object,
-                                        const std::shared_ptr<Scope>& scope);
+                                        const ScopePtr& scope);
 
   ObjectPtr<> value_;
 };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <lispp/isolate_pool.h>
+
+namespace lispp {
+
+// NOTE: Script of the batch: the file at path if it's set, otherwise
+//       the code itself
+struct BatchInput {
+  std::string name;
+  std::string path;
+  std::string code;
+};
+
+struct BatchResult {
+  std::string name;
+  bool succeeded = false;
+  // NOTE: everything printed by the script
+  std::string output;
+  // NOTE: printed value of the last form
+  std::string value;
+  std::string error;
+};
+
+using BatchResultHandler = std::function<void(const BatchResult& result)>;
+
+// NOTE: Evaluates every input in its own isolate on the pool. Results are
+//       passed to the handler in the input order as soon as all the
+//       previous ones are ready. Returns the number of failed inputs
+std::size_t run_batch(IsolatePool& pool, const std::vector<BatchInput>& inputs,
+                      const BatchResultHandler& handler);
+
+} // lispp
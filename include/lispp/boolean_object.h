@@ -4,37 +4,48 @@
 
 namespace lispp {
 
+// NOTE: There are only two immortal objects #t and #f (see make),
+//       so booleans are compared by pointers (see is_true_value)
 class BooleanObject : public Object {
 public:
-  BooleanObject() = default;
-  explicit BooleanObject(bool value) : value_(value) {}
   ~BooleanObject() {}
 
   static std::string GetTypeName() {
     return "boolean";
   }
 
+  static ObjectPtr<BooleanObject> make(bool value) {
+    return (value ? &true_object_ : &false_object_);
+  }
+
+  static const BooleanObject* get_true() { return &true_object_; }
+  static const BooleanObject* get_false() { return &false_object_; }
+
   bool get_value() const { return value_; }
-  void set_value(bool value) { value_ = value; }
 
   BooleanObject* as_boolean() override { return this; }
   const BooleanObject* as_boolean() const override { return this; }
 
   bool operator==(const Object& other) const override {
-    const auto* other_identifier = other.as_boolean();
-    return (other_identifier != nullptr && other_identifier->value_ == value_);
+    return (&other == this);
   }
 
   std::string to_string() const override {
     return (value_ ? "#t" : "#f");
   }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>&) override {
+  ObjectPtr<> eval(const ScopePtr&) override {
     return this;
   }
 
-protected:
-  bool value_ = false;
+private:
+  constexpr explicit BooleanObject(bool value)
+      : Object(true), value_(value) {}
+
+  static BooleanObject true_object_;
+  static BooleanObject false_object_;
+
+  const bool value_;
 };
 
 inline std::ostream& operator<<(std::ostream& out, const BooleanObject& obj) {
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+#include <lispp/token.h>
+#include <lispp/tokenizer.h>
+
+namespace lispp {
+
+// NOTE: Tokenizer over a contiguous buffer of text. It scans the buffer by
+//       offsets, the text of tokens is a view into it (nothing is copied).
+//       The buffer is either given as is (it must outlive the tokenizer)
+//       or owned by subclasses which read their input by chunks (see
+//       refill). The text of the current and the peeked tokens is kept in
+//       the buffer on refills
+class BufferTokenizer : public ITokenizer {
+public:
+  BufferTokenizer() = default;
+  BufferTokenizer(const char* data, std::size_t size);
+  ~BufferTokenizer() override;
+
+  const Token& next_token() override;
+  const Token& current_token() override;
+  const Token& peek_token() override;
+  bool has_more_tokens() override;
+
+  int get_current_line() override;
+  // NOTE: skips the rest of the buffer and forgets the tokens
+  void clear() override;
+
+protected:
+  // NOTE: position is the offset of the first char which is not scanned
+  //       yet. The chars before it may be dropped from the new buffer
+  //       (up to get_consumed_count of them), the text of the tokens
+  //       is moved to the new buffer
+  void set_buffer(const char* data, std::size_t size,
+                  std::size_t position = 0);
+  const char* get_data() const { return data_; }
+  std::size_t get_size() const { return size_; }
+  std::size_t get_position() const { return position_; }
+  // NOTE: number of the first chars of the buffer which are not needed
+  //       anymore (scanned and not referred by the tokens)
+  std::size_t get_consumed_count() const;
+
+  // NOTE: Called when the scan reaches the end of the buffer. Subclasses
+  //       reading by chunks append the next chunk to the buffer, may drop
+  //       the first consumed_count chars of it and set it with
+  //       set_buffer(data, size, position - dropped_count) if anything is
+  //       appended. Returns false if there is no more input
+  virtual bool refill(std::size_t consumed_count);
+
+private:
+  Token parse_token();
+  Token parse_characters_token();
+  bool is_symbol_token_start(char current_char);
+  Token parse_symbol_token();
+  Token parse_number_token();
+  Token parse_one_symbol_token();
+
+  // NOTE: makes count chars available after the position (refilling the
+  //       buffer), returns false if there are less of them in the input
+  bool ensure_chars(std::size_t count);
+
+  // NOTE: moves the position to the first char not accepted by the scanner:
+  //       scanner(begin, end) returns the end of the accepted chars
+  template<typename Scanner>
+  void skip_while(Scanner scanner);
+
+  Token make_text_token(TokenType type, std::size_t begin_offset = 0,
+                        std::size_t end_offset = 0) const {
+    return Token(type, data_ + token_begin_ + begin_offset,
+                 position_ - token_begin_ - begin_offset - end_offset);
+  }
+
+  bool is_in_buffer(const char* text) const {
+    return text != nullptr && text >= data_ && text <= data_ + size_;
+  }
+
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t position_ = 0;
+  // NOTE: offset of the token being scanned, the buffer is kept from it
+  std::size_t token_begin_ = 0;
+
+  Token next_token_;
+  Token current_token_;
+  int current_line_ = 0;
+};
+
+} // lispp
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <ostream>
+
 #include <lispp/callable_object.h>
 #include <lispp/simple_callable_object.h>
 #include <lispp/scope.h>
@@ -10,112 +12,124 @@ namespace lispp {
 namespace builtins {
 
 // Basic macro
-ObjectPtr<> cond_macro(const std::shared_ptr<Scope>& scope,
-                       const std::vector<ObjectPtr<>>& args);
+// NOTE: macroses returning TailResult leave the expression in tail position
+//       unevaluated (see run_trampoline)
+TailResult cond_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> if_macro(const std::shared_ptr<Scope>& scope,
-                     const std::vector<ObjectPtr<>>& args);
+TailResult if_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> quote_macro(const std::shared_ptr<Scope>&,
-                        const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> quote_macro(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> eval_macro(const std::shared_ptr<Scope>& scope,
-                       const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> eval_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> not_macro(const std::shared_ptr<Scope>& scope,
-                      const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> not_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> or_macro(const std::shared_ptr<Scope>& scope,
-                     const std::vector<ObjectPtr<>>& args);
+TailResult or_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> and_macro(const std::shared_ptr<Scope>& scope,
-                      const std::vector<ObjectPtr<>>& args);
+TailResult and_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> let_macro(const std::shared_ptr<Scope>& scope,
-                      const std::vector<ObjectPtr<>>& args);
+TailResult let_macro(const ScopePtr& scope, ArgsSpan args);
 
 // function & macro definning,
-ObjectPtr<> lambda_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> lambda_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> define_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> define_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> defmacro_macro(const std::shared_ptr<Scope>& scope,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> defmacro_macro(const ScopePtr& scope, ArgsSpan args);
 
 // setters
-ObjectPtr<> set_macro(const std::shared_ptr<Scope>& scope,
-                      const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> set_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> setcar_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> setcar_macro(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> setcdr_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> setcdr_macro(const ScopePtr& scope, ArgsSpan args);
 
 // list operations
-ObjectPtr<> cons_function(const std::shared_ptr<Scope>&,
-                          const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> cons_function(const ScopePtr&, ArgsSpan args);
+
+ObjectPtr<> car_function(const ScopePtr&, ArgsSpan args);
+
+ObjectPtr<> cdr_function(const ScopePtr&, ArgsSpan args);
+
+// NOTE: native versions of the list stdlib. They are iterative, so they work
+//       in constant C++ stack. Reference definitions in Lisp are in
+//       stdlib/list.lisp (see init_scope_with_reference_stdlibs)
+ObjectPtr<> length_function(const ScopePtr&, ArgsSpan args);
+
+ObjectPtr<> list_tail_function(const ScopePtr&, ArgsSpan args);
+
+ObjectPtr<> append_function(const ScopePtr&, ArgsSpan args);
+
+ObjectPtr<> reverse_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> car_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> map_function(const ScopePtr& scope, ArgsSpan args);
 
-ObjectPtr<> cdr_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> filter_function(const ScopePtr& scope, ArgsSpan args);
+
+ObjectPtr<> member_function(const ScopePtr&, ArgsSpan args);
+
+ObjectPtr<> foldr_function(const ScopePtr& scope, ArgsSpan args);
+
+ObjectPtr<> make_list_function(const ScopePtr&, ArgsSpan args);
+
+// NOTE: (pmap f lst [grain]) and (pfor-each f lst [grain]) call f for the
+//       chunks of grain elements in parallel by isolates (see IsolatePool).
+//       The function and the elements are copied to the isolates and the
+//       results are copied back (see ObjectSnapshot), so side effects of
+//       the calls (set!, define) are not visible to the caller, except
+//       for the first chunk which is called by the caller itself
+ObjectPtr<> pmap_function(const ScopePtr& scope, ArgsSpan args);
+
+ObjectPtr<> pfor_each_function(const ScopePtr& scope, ArgsSpan args);
 
 // type prediates
-ObjectPtr<> nullp_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> nullp_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> numberp_function(const std::shared_ptr<Scope>&,
-                             const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> numberp_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> booleanp_function(const std::shared_ptr<Scope>&,
-                              const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> booleanp_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> consp_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> consp_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> listp_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> listp_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> symbolp_function(const std::shared_ptr<Scope>&,
-                             const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> symbolp_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> stringp_function(const std::shared_ptr<Scope>&,
-                             const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> stringp_function(const ScopePtr&, ArgsSpan args);
 
 // number actions
-ObjectPtr<> plus_function(const std::shared_ptr<Scope>&,
-                          const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> plus_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> minus_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> minus_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> mul_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> mul_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> div_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> div_function(const ScopePtr&, ArgsSpan args);
 
 // misc functions
-ObjectPtr<> string_len_function(const std::shared_ptr<Scope>&,
-                                const std::vector<ObjectPtr<>>& args);
+// NOTE: stream print writes to (std::cout by default). Thread-local, so
+//       isolates on different threads may have their own ones
+std::ostream& get_output_stream();
+// NOTE: nullptr restores std::cout
+void set_output_stream(std::ostream* out);
+
+ObjectPtr<> string_len_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> print_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> print_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> exit_function(const std::shared_ptr<Scope>&,
-                          const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> exit_function(const ScopePtr&, ArgsSpan args);
 
-ObjectPtr<> throw_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args);
+ObjectPtr<> throw_function(const ScopePtr&, ArgsSpan args);
 } // builtins
 
-void init_global_scope(const std::shared_ptr<Scope>& scope);
+void init_global_scope(const ScopePtr& scope);
+// NOTE: Frozen scope with builtins and stdlibs built once per process.
+//       Global scopes of VMs are its children (see Scope::freeze)
+ScopePtr get_base_scope();
 
-void init_scope_with_builtins(const std::shared_ptr<Scope>& scope);
-void init_scope_with_stdlibs(const std::shared_ptr<Scope>& scope);
+void init_scope_with_builtins(const ScopePtr& scope);
+void init_scope_with_stdlibs(const ScopePtr& scope);
+// NOTE: replaces the native list functions with their Lisp definitions
+void init_scope_with_reference_stdlibs(const ScopePtr& scope);
 
 } // lispp
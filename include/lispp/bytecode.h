@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+#include <lispp/scope.h>
+
+namespace lispp {
+
+enum class OpCode {
+  kLoadConst,        // push constants[arg]
+  kLoadNil,          // push nil
+  kLoadVar,          // push value of names[arg] looked up by name starting
+                     //   from the extra_arg-th ancestor of the current scope
+  kLoadGlobal,       // the same as kLoadVar for names which are not defined
+                     //   in the enclosing frames, cached in global_caches[arg]
+  kLoadLocal,        // push slot arg of the extra_arg-th ancestor scope
+  kDefineVar,        // pop value and define names[arg] in the current scope
+  kSetVar,           // pop value and replace names[arg] (set!) starting
+                     //   from the extra_arg-th ancestor of the current scope
+  kSetLocal,         // pop value into slot arg of the extra_arg-th ancestor
+  kPop,              // drop the top of the stack
+  kJump,             // pc = arg
+  kJumpIfFalse,      // pop condition, pc = arg if it is false
+  kJumpIfFalseKeep,  // pc = arg if top is false (keep it), pop otherwise
+  kJumpIfTrueKeep,   // pc = arg if top is true (keep it), pop otherwise
+  kMakeClosure,      // push closure of lambdas[arg] over the current scope
+  kPrepareCall,      // check callable on top; if it is a macro, expand form
+                     //   constants[arg] in place and pc = extra_arg
+  kCallMacro,        // pop callable, push its result for form constants[arg]
+  kCall,             // call stack[-arg - 1] with arg values from the top
+  kTailCall,         // the same as kCall but reuses the current frame
+  kEnterScope,       // create child scope of the current one with slots
+                     //   layouts[arg] and pop the slots values
+  kLeaveScope,       // return to the parent of the current scope
+  kEvalForm,         // push tree-walking eval of constants[arg]
+  kReturn            // pop result and leave the current frame
+};
+
+struct Instruction final {
+  Instruction() = default;
+  explicit Instruction(OpCode opcode, int arg = 0, int extra_arg = 0)
+      : opcode(opcode), arg(arg), extra_arg(extra_arg) {}
+
+  OpCode opcode = OpCode::kReturn;
+  int arg = 0;
+  int extra_arg = 0;
+};
+
+struct LambdaTemplate;
+
+// NOTE: Inline cache of kLoadGlobal. Entries are keyed by the scope the
+//       lookup starts from (several of them for polymorphic sites) and are
+//       valid while the version of the scope (see Scope::get_version) is
+//       unchanged. Values are not owned: the scope keeps them until the
+//       version is bumped
+struct GlobalCache final {
+  static constexpr std::size_t kEntriesCount = 4;
+
+  struct Entry {
+    const Scope* scope = nullptr;
+    std::uint64_t version = 0;
+    Object* value = nullptr;
+  };
+
+  Entry entries[kEntriesCount];
+  std::size_t next_entry = 0;
+};
+
+struct CodeObject final {
+  std::vector<Instruction> instructions;
+  std::vector<ObjectPtr<>> constants;
+  std::vector<SymbolId> names;
+  // NOTE: indexed as names
+  std::vector<GlobalCache> global_caches;
+  std::vector<std::shared_ptr<LambdaTemplate>> lambdas;
+  std::vector<std::shared_ptr<const SlotNames>> layouts;
+};
+
+// NOTE: Compile-time view of a lexically addressed frame (lambda or let).
+//       Names assigned by define are not slots: they are kept in the hash map
+//       of the scope and referenced by name.
+struct FrameLayout final {
+  explicit FrameLayout(const std::shared_ptr<const SlotNames>& slot_names)
+      : slot_names(slot_names) {}
+
+  std::shared_ptr<const SlotNames> slot_names;
+  std::unordered_set<SymbolId> defined_names;
+  // NOTE: the body may define names the compiler doesn't see (by eval,
+  //       macroses or forms left for the tree-walking eval)
+  bool has_runtime_defines = false;
+};
+
+// NOTE: Compiled lambda without closure. Body is compiled on the first call
+//       so macroses defined after the lambda are expanded correctly.
+//       Slots are the arguments followed by the rest argument (if any).
+struct LambdaTemplate final {
+  std::string name;
+  std::size_t args_count = 0;
+  bool has_rest_arg = false;
+  std::vector<ObjectPtr<>> body;
+
+  std::shared_ptr<const SlotNames> slot_names;
+  // NOTE: frames of the enclosing lambdas/lets, the innermost is the last
+  std::vector<std::shared_ptr<FrameLayout>> enclosing_frames;
+
+  // NOTE: compiled once on the first call (closures of the frozen scope
+  //       are called from several threads)
+  std::once_flag compile_once;
+  std::shared_ptr<CodeObject> code;
+};
+
+std::ostream& operator<<(std::ostream& out, OpCode opcode);
+std::ostream& operator<<(std::ostream& out, const Instruction& instruction);
+std::ostream& operator<<(std::ostream& out, const CodeObject& code);
+
+} // lispp
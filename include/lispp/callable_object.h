@@ -2,16 +2,57 @@
 
 #include <vector>
 
+#include <lispp/args_span.h>
 #include <lispp/object.h>
 #include <lispp/scope.h>
 
 namespace lispp {
 
+class CompiledCallableObject;
+
 enum class CallableType {
   kFunction,
   kMacro
 };
 
+// NOTE: Builtin macroses which are known to the bytecode compiler
+enum class SpecialForm {
+  kNone,
+  kQuote,
+  kIf,
+  kCond,
+  kDefine,
+  kSet,
+  kLambda,
+  kLet,
+  kAnd,
+  kOr
+};
+
+// NOTE: Result of evaluation with unevaluated expression in tail position.
+//       If scope is set, value is an expression which should be evaluated
+//       in the scope (see run_trampoline), otherwise it's the result itself.
+struct TailResult {
+  TailResult() = default;
+  // non-explicit
+  TailResult(const ObjectPtr<>& value) : value(value) {}
+  TailResult(const ObjectPtr<>& expression,
+             const ScopePtr& scope)
+      : value(expression), scope(scope) {}
+
+  bool is_tail() const { return bool(scope); }
+
+  ObjectPtr<> value;
+  ScopePtr scope;
+};
+
+// NOTE: Evaluates expression except the call in its tail position
+TailResult eval_tail(const ObjectPtr<>& expression,
+                     const ScopePtr& scope);
+
+// NOTE: Evaluates tail expressions in the loop (in constant C++ stack)
+ObjectPtr<> run_trampoline(TailResult result);
+
 class CallableObject : public Object {
 public:
   explicit CallableObject(CallableType type = CallableType::kFunction,
@@ -25,23 +66,43 @@ public:
   CallableObject* as_callable() override { return this; }
   const CallableObject* as_callable() const override { return this; }
 
+  virtual CompiledCallableObject* as_compiled_callable() { return nullptr; }
+
   std::string to_string() const override;
   CallableType get_type() const { return type_; }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>&) override { return this; }
-  ObjectPtr<> execute(const std::shared_ptr<Scope>& scope,
-                      const ObjectPtr<>& args);
+  SpecialForm get_special_form() const { return special_form_; }
+  void set_special_form(SpecialForm special_form) {
+    special_form_ = special_form;
+  }
+
+  ObjectPtr<> eval(const ScopePtr&) override { return this; }
+  // NOTE: args are the unevaluated list of the call form
+  virtual ObjectPtr<> execute(const ScopePtr& scope,
+                              const ObjectPtr<>& args);
+  virtual TailResult execute_tail(const ScopePtr& scope,
+                                  const ObjectPtr<>& args);
+
+  // NOTE: args are passed as is (already evaluated for functions)
+  ObjectPtr<> call(const ScopePtr& scope, ArgsSpan args);
 
 protected:
-  virtual ObjectPtr<> execute_impl(const std::shared_ptr<Scope>& scope,
-                               const std::vector<ObjectPtr<>>& args) = 0;
+  virtual ObjectPtr<> execute_impl(const ScopePtr& scope, ArgsSpan args) = 0;
+  virtual TailResult execute_tail_impl(const ScopePtr& scope, ArgsSpan args) {
+    return execute_impl(scope, args);
+  }
 
 private:
-  ObjectPtr<> prepare_args(const ObjectPtr<>& src_args,
-                           const std::shared_ptr<Scope>& scope) const;
+  ScopePtr get_local_scope(
+      const ScopePtr& scope) const;
+
+  // NOTE: evaluates the args of functions straight into the buffer
+  void prepare_args(const ObjectPtr<>& src_args, const ScopePtr& scope,
+                    ArgsBuffer* args) const;
 
   CallableType type_ = CallableType::kFunction;
   bool create_separate_scope_ = false;
+  SpecialForm special_form_ = SpecialForm::kNone;
 };
 
 std::ostream& operator<<(std::ostream& out, const CallableObject& obj);
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace lispp {
+
+// NOTE: Internal: the classes of chars shared by BufferTokenizer and the
+//       pre-scan of ParallelParser, so the chunks are cut where the tokens
+//       end. The vectorized scans must stop at the same chars as the table
+//       (see test_char_classes.cpp)
+enum CharClass : std::uint8_t {
+  kWhiteSpace = 1 << 0, // except end of line
+  kSign = 1 << 1,
+  kDigitExt = 1 << 2, // digits, signs and dot
+  kInitialOfSymbol = 1 << 3,
+  kSymbolChar = 1 << 4,
+  kLineEnd = 1 << 5,
+  kPrefix = 1 << 6, // quote, comma and back tick
+  kScanStop = 1 << 7 // brackets, string quotes and end of line
+};
+
+// NOTE: classes of all the chars (ASCII only: other chars have none)
+class CharClassTable {
+public:
+  CharClassTable() {
+    for (char c : {' ', '\t', '\v', '\f', '\r'}) {
+      add(c, kWhiteSpace);
+    }
+    add('\n', kLineEnd | kScanStop);
+    for (char c = '0'; c <= '9'; ++c) {
+      add(c, kDigitExt | kSymbolChar);
+    }
+    for (char c : {'+', '-'}) {
+      add(c, kSign | kDigitExt | kSymbolChar);
+    }
+    add('.', kDigitExt | kSymbolChar);
+    for (char c = 'a'; c <= 'z'; ++c) {
+      add(c, kInitialOfSymbol | kSymbolChar);
+      add(c - 'a' + 'A', kInitialOfSymbol | kSymbolChar);
+    }
+    for (char c : std::string("!$%&*/:<=>?~_^#")) {
+      add(c, kInitialOfSymbol | kSymbolChar);
+    }
+    for (char c : {'\'', ',', '`'}) {
+      add(c, kPrefix);
+    }
+    for (char c : {'(', ')', '"'}) {
+      add(c, kScanStop);
+    }
+  }
+
+  bool is(char c, std::uint8_t char_class) const {
+    return (classes_[static_cast<unsigned char>(c)] & char_class) != 0;
+  }
+
+private:
+  void add(char c, int char_class) {
+    classes_[static_cast<unsigned char>(c)] |= char_class;
+  }
+
+  std::uint8_t classes_[256] = {};
+};
+
+// NOTE: one per translation unit, so it's built before the static objects
+//       of the unit which may use it
+const CharClassTable kCharClasses;
+
+inline const char* skip_class(const char* begin, const char* end,
+                              std::uint8_t char_class) {
+  while (begin != end && kCharClasses.is(*begin, char_class)) {
+    ++begin;
+  }
+  return begin;
+}
+
+inline const char* skip_to_class(const char* begin, const char* end,
+                                 std::uint8_t char_class) {
+  while (begin != end && !kCharClasses.is(*begin, char_class)) {
+    ++begin;
+  }
+  return begin;
+}
+
+inline const char* skip_to_quotes(const char* begin, const char* end) {
+  const void* quotes = std::memchr(begin, '"', end - begin);
+  return (quotes != nullptr ? static_cast<const char*>(quotes) : end);
+}
+
+#if defined(__SSE2__)
+namespace sse2 {
+
+  // NOTE: mask of the bytes in [low, high]
+  inline __m128i in_range(__m128i chars, char low, char high) {
+    const __m128i offsets = _mm_sub_epi8(chars, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(
+        _mm_subs_epu8(offsets, _mm_set1_epi8(high - low)),
+        _mm_setzero_si128());
+  }
+
+  inline __m128i equal(__m128i chars, char c) {
+    return _mm_cmpeq_epi8(chars, _mm_set1_epi8(c));
+  }
+
+  // NOTE: the first char of the mask in the block of 16 chars (end if none)
+  template<typename MaskFunc>
+  const char* skip_blocks(const char* begin, const char* end,
+                          MaskFunc mask_func) {
+    for (; end - begin >= 16; begin += 16) {
+      const __m128i chars =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+      const int bits = _mm_movemask_epi8(mask_func(chars));
+      if (bits != 0) {
+        return begin + __builtin_ctz(bits);
+      }
+    }
+    return begin;
+  }
+
+  // NOTE: the chars which are not symbol chars: spaces, control and
+  //       non-ASCII chars (less than '!' as signed) and the punctuation
+  inline __m128i not_symbol_chars(__m128i chars) {
+    __m128i mask = _mm_cmplt_epi8(chars, _mm_set1_epi8('!'));
+    mask = _mm_or_si128(mask, equal(chars, '"'));
+    mask = _mm_or_si128(mask, in_range(chars, '\'', ')'));
+    mask = _mm_or_si128(mask, equal(chars, ','));
+    mask = _mm_or_si128(mask, equal(chars, ';'));
+    mask = _mm_or_si128(mask, equal(chars, '@'));
+    mask = _mm_or_si128(mask, in_range(chars, '[', ']'));
+    mask = _mm_or_si128(mask, equal(chars, '`'));
+    mask = _mm_or_si128(mask, in_range(chars, '{', '}'));
+    return _mm_or_si128(mask, equal(chars, '\x7f'));
+  }
+
+  inline __m128i scan_stops(__m128i chars) {
+    __m128i mask = in_range(chars, '(', ')');
+    mask = _mm_or_si128(mask, equal(chars, '"'));
+    return _mm_or_si128(mask, equal(chars, '\n'));
+  }
+
+} // namespace sse2
+#endif
+
+inline const char* skip_symbol_chars(const char* begin, const char* end) {
+#if defined(__SSE2__)
+  begin = sse2::skip_blocks(begin, end, sse2::not_symbol_chars);
+#endif
+  return skip_class(begin, end, kSymbolChar);
+}
+
+// NOTE: the chars the pre-scan of ParallelParser stops at
+inline const char* skip_to_scan_stop(const char* begin, const char* end) {
+#if defined(__SSE2__)
+  begin = sse2::skip_blocks(begin, end, sse2::scan_stops);
+#endif
+  return skip_to_class(begin, end, kScanStop);
+}
+
+} // lispp
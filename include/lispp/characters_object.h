@@ -3,6 +3,7 @@
 #include <string>
 
 #include <lispp/object.h>
+#include <lispp/object_pool.h>
 
 namespace lispp {
 
@@ -17,6 +18,14 @@ public:
     return "characters";
   }
 
+  // NOTE: allocated from ObjectPool
+  static void* operator new(std::size_t size) {
+    return ObjectPool::allocate(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    ObjectPool::deallocate(ptr, size);
+  }
+
   const std::string& get_value() const { return value_; }
   void set_value(const std::string& value) { value_ = value; }
 
@@ -32,7 +41,7 @@ public:
     return "\"" + value_ + "\"";
   }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>&) override { return this; }
+  ObjectPtr<> eval(const ScopePtr&) override { return this; }
 
 protected:
   std::string value_;
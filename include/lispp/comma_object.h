@@ -1,5 +1,6 @@
 #pragma once
 
+#include <lispp/cycle_collector.h>
 #include <lispp/object.h>
 #include <lispp/object_ptr.h>
 
@@ -24,6 +25,11 @@ public:
   CommaObject* as_comma() override { return this; }
   const CommaObject* as_comma() const override { return this; }
 
+  void traverse(ReferenceVisitor& visitor) const override {
+    visitor.visit(value_);
+  }
+  void clear_references() override { value_.reset(); }
+
   bool operator==(const Object& other) const override {
     const auto* other_comma = other.as_comma();
     return (other_comma != nullptr && value_.safe_equal(other_comma->value_));
@@ -33,7 +39,7 @@ public:
     return "," + (value_.valid() ? value_->to_string() : "nil");
   }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>& scope) override {
+  ObjectPtr<> eval(const ScopePtr& scope) override {
     return (value_.valid() ? value_->eval(scope) : nullptr);
   }
 
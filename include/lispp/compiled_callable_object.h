@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include <lispp/bytecode.h>
+#include <lispp/callable_object.h>
+
+namespace lispp {
+
+// NOTE: Closure created by bytecode (kMakeClosure)
+class CompiledCallableObject : public CallableObject {
+public:
+  CompiledCallableObject(const std::shared_ptr<LambdaTemplate>& lambda,
+                         const ScopePtr& closure);
+
+  CompiledCallableObject* as_compiled_callable() override { return this; }
+
+  const std::string& get_name() const { return lambda_->name; }
+  const std::shared_ptr<LambdaTemplate>& get_lambda() const { return lambda_; }
+  const ScopePtr& get_closure() const { return closure_; }
+
+  // NOTE: compiles the body on the first call
+  const std::shared_ptr<CodeObject>& get_code();
+
+  ScopePtr create_frame(ArgsSpan args) const;
+
+  // NOTE: references of the lambda template (body, constants) are shared
+  //       between closures and are not traversed
+  void traverse(ReferenceVisitor& visitor) const override;
+  void clear_references() override;
+
+protected:
+  ObjectPtr<> execute_impl(const ScopePtr& scope, ArgsSpan args) override;
+
+private:
+  std::shared_ptr<LambdaTemplate> lambda_;
+  ScopePtr closure_;
+};
+
+} // lispp
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lispp/bytecode.h>
+#include <lispp/callable_object.h>
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+#include <lispp/scope.h>
+
+namespace lispp {
+
+// NOTE: Lowers parsed forms into bytecode for Interpreter.
+//       Special forms are recognized by values of the operator symbols in the
+//       scope the code is compiled for. Everything compiler doesn't know
+//       (user macroses, backticks, malformed special forms) is left for
+//       the tree-walking eval, so compiling never throws.
+//       Arguments and let variables are resolved to (depth, slot) addresses
+//       of the frames, other variables are looked up by name (through the
+//       frames if some of them may get names defined at run time).
+class Compiler {
+public:
+  explicit Compiler(const ScopePtr& scope);
+
+  std::shared_ptr<CodeObject> compile(const ObjectPtr<>& form);
+  std::shared_ptr<CodeObject> compile_lambda(const LambdaTemplate& lambda);
+
+private:
+  void compile_expression(const ObjectPtr<>& form, bool tail);
+  void compile_variable(SymbolId name, bool tail);
+  void compile_body(const std::vector<ObjectPtr<>>& body, bool tail);
+  void compile_cons(const ObjectPtr<ConsObject>& form, bool tail);
+  void compile_call(const ObjectPtr<ConsObject>& form, bool tail);
+  void compile_macro_call(const ObjectPtr<ConsObject>& form, bool tail);
+  void compile_fallback(const ObjectPtr<>& form, bool tail);
+  void compile_condition(const ObjectPtr<>& condition);
+
+  bool compile_special_form(SpecialForm special_form,
+                            const ObjectPtr<ConsObject>& form, bool tail);
+  bool compile_quote(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_if(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_cond(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_define(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_set(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_lambda_form(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_let(const std::vector<ObjectPtr<>>& args, bool tail);
+  bool compile_and_or(const std::vector<ObjectPtr<>>& args, bool is_and,
+                      bool tail);
+
+  std::shared_ptr<LambdaTemplate> make_lambda_template(
+      const std::string& name, const ObjectPtr<>& arg_list,
+      std::vector<ObjectPtr<>>::const_iterator body_begin,
+      std::vector<ObjectPtr<>>::const_iterator body_end);
+
+  ObjectPtr<CallableObject> resolve_macro(const ObjectPtr<>& op) const;
+  // NOTE: slot is -1 if the variable is looked up by name starting from
+  //       the depth-th ancestor scope (globals and names assigned by define)
+  void resolve_variable(SymbolId name, int* depth, int* slot) const;
+  bool is_local(SymbolId name) const;
+  bool may_define_at_run_time(const ObjectPtr<>& form) const;
+  bool may_define_at_run_time(const std::vector<ObjectPtr<>>& body) const;
+  bool has_runtime_defines() const;
+  void add_defined_name(SymbolId name);
+
+  int emit(OpCode opcode, int arg = 0, int extra_arg = 0);
+  void emit_return(bool tail);
+  int current_position() const;
+  void patch_jump(int instruction_index, int target);
+
+  int add_constant(const ObjectPtr<>& constant);
+  int add_name(SymbolId name);
+  int add_lambda(const std::shared_ptr<LambdaTemplate>& lambda);
+  int add_layout(const std::shared_ptr<const SlotNames>& layout);
+
+  ScopePtr scope_;
+  std::shared_ptr<CodeObject> code_;
+  std::unordered_map<SymbolId, int> name_indices_;
+  std::vector<std::shared_ptr<FrameLayout>> frames_;
+};
+
+} // lispp
@@ -3,10 +3,13 @@
 #include <sstream>
 
 #include <lispp/object.h>
+#include <lispp/object_pool.h>
 #include <lispp/object_ptr.h>
 
 namespace lispp {
 
+struct TailResult;
+
 class ConsObject : public Object {
 public:
   ConsObject() = default;
@@ -20,6 +23,14 @@ public:
     return "cons";
   }
 
+  // NOTE: allocated from ObjectPool
+  static void* operator new(std::size_t size) {
+    return ObjectPool::allocate(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    ObjectPool::deallocate(ptr, size);
+  }
+
   ObjectPtr<> get_left_value() { return left_value_; }
   const ObjectPtr<> get_left_value() const { return left_value_; }
   void set_left_value(const ObjectPtr<>& left_value) {
@@ -37,7 +48,11 @@ public:
 
   bool operator==(const Object& other) const override;
   std::string to_string() const override;
-  ObjectPtr<> eval(const std::shared_ptr<Scope>& scope) override;
+  ObjectPtr<> eval(const ScopePtr& scope) override;
+  TailResult eval_tail(const ScopePtr& scope);
+
+  void traverse(ReferenceVisitor& visitor) const override;
+  void clear_references() override;
 
 private:
   void print_as_tail(std::ostream& out) const;
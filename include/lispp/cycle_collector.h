@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+
+namespace lispp {
+
+class Scope;
+
+// NOTE: Enumerates owned references of objects and scopes
+//       (see Object::traverse and Scope::traverse)
+class ReferenceVisitor {
+public:
+  virtual ~ReferenceVisitor() = default;
+
+  virtual void visit(const ObjectPtr<>& object) = 0;
+  virtual void visit(const ScopePtr& scope) = 0;
+};
+
+struct CycleCollectorStats {
+  std::size_t collections = 0;
+  std::size_t scopes_freed = 0;
+  std::size_t objects_freed = 0;
+};
+
+// NOTE: Intrusive list node of scopes tracked by the collector
+struct CycleCollectorLink {
+  Scope* scope = nullptr;
+  CycleCollectorLink* prev = nullptr;
+  CycleCollectorLink* next = nullptr;
+};
+
+// NOTE: Trial-deletion collector of reference cycles between closures and
+//       scopes (e.g. a function defined inside another function is stored
+//       in the scope it captures).
+//       Scopes are tracked when a closure captures them. Collection visits
+//       everything reachable from the tracked scopes, treats the nodes
+//       whose ref counts are not explained by references inside this graph
+//       as roots, and clears the references of the nodes unreachable from
+//       the roots, which frees them.
+//       References which are not enumerated by traverse make the collector
+//       conservative only.
+//       Collectors are per-thread: scopes and closures must not be shared
+//       between threads.
+class CycleCollector {
+public:
+  static constexpr std::size_t kDefaultThreshold = 10000;
+
+  static CycleCollector& get_current();
+  // NOTE: true after the collector of the thread is destroyed on its exit
+  static bool is_destroyed();
+
+  void track(Scope* scope);
+  void untrack(Scope* scope);
+
+  // NOTE: Collects if more than threshold scopes were tracked since the last
+  //       collection. Should be called when no raw pointers to objects are
+  //       held (e.g. between evaluations of top level forms)
+  bool maybe_collect();
+
+  // NOTE: returns stats of this collection only
+  CycleCollectorStats collect();
+
+  const CycleCollectorStats& get_stats() const { return stats_; }
+  std::size_t get_tracked_count() const { return tracked_count_; }
+
+  // NOTE: 0 disables automatic collection
+  void set_threshold(std::size_t threshold) { threshold_ = threshold; }
+  std::size_t get_threshold() const { return threshold_; }
+
+private:
+  CycleCollector();
+  ~CycleCollector();
+  CycleCollector(const CycleCollector&) = delete;
+  CycleCollector& operator=(const CycleCollector&) = delete;
+
+  // NOTE: sentinel of the list of tracked scopes
+  CycleCollectorLink tracked_;
+  std::size_t tracked_count_ = 0;
+  std::size_t tracked_since_collection_ = 0;
+  std::size_t threshold_ = kDefaultThreshold;
+  CycleCollectorStats stats_;
+};
+
+} // lispp
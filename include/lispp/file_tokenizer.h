@@ -1,20 +1,33 @@
 #pragma once
 
-#include <fstream>
+#include <cstddef>
+#include <string>
 
-#include <lispp/istream_tokenizer.h>
+#include <lispp/buffer_tokenizer.h>
 
 namespace lispp {
 
-class FileTokenizer : public IstreamTokenizer {
+// NOTE: Maps the whole file into memory and scans the mapping (it's read
+//       ahead sequentially), so the file isn't copied to a buffer of the
+//       tokenizer. Files which can't be mapped (pipes) are read into
+//       a buffer. Throws TokenizerError if the file can't be opened
+class FileTokenizer : public BufferTokenizer {
 public:
-  FileTokenizer(const std::string& filename)
-      : input_file_(filename) {
-    set_input_stream(input_file_);
-  }
+  explicit FileTokenizer(const std::string& filename);
+  ~FileTokenizer() override;
+  FileTokenizer(const FileTokenizer&) = delete;
+  FileTokenizer& operator=(const FileTokenizer&) = delete;
+
+  bool is_mapped() const { return mapping_ != nullptr; }
+
+  // NOTE: the whole text of the file (see ParallelParser)
+  using BufferTokenizer::get_data;
+  using BufferTokenizer::get_size;
 
 private:
-  std::ifstream input_file_;
+  void* mapping_ = nullptr;
+  std::size_t mapping_size_ = 0;
+  std::string buffer_;
 };
 
 } // lispp
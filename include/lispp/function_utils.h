@@ -4,6 +4,7 @@
 
 #include <lispp/object.h>
 #include <lispp/object_ptr.h>
+#include <lispp/boolean_object.h>
 #include <lispp/callable_object.h>
 #include <lispp/scope.h>
 
@@ -14,10 +15,16 @@ public:
   using runtime_error::runtime_error;
 };
 
-bool is_true_value(const ObjectPtr<>& object);
+// NOTE: everything but #f is true (nil too)
+inline bool is_true_value(const ObjectPtr<>& object) {
+  return (object.get() != BooleanObject::get_false());
+}
 
 bool is_true_condition(const ObjectPtr<>& condition,
-                       const std::shared_ptr<Scope>& scope);
+                       const ScopePtr& scope);
+
+// NOTE: unique names like <lambda#0> for anonymous functions
+std::string make_lambda_name();
 
 constexpr int kInvalidArgNumber = -1;
 
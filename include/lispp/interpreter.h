@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <lispp/bytecode.h>
+#include <lispp/compiled_callable_object.h>
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+#include <lispp/scope.h>
+
+namespace lispp {
+
+// NOTE: Stack-based dispatch loop over CodeObject.
+//       Calls of compiled closures push frames instead of recursion,
+//       so they don't consume C++ stack (and tail calls reuse the frame).
+class Interpreter {
+public:
+  Interpreter() = default;
+  Interpreter(const Interpreter&) = delete;
+  Interpreter& operator=(const Interpreter&) = delete;
+
+  ObjectPtr<> run(const std::shared_ptr<CodeObject>& code,
+                  const ScopePtr& scope);
+  ObjectPtr<> call(const ObjectPtr<CompiledCallableObject>& callable,
+                   ArgsSpan args);
+
+private:
+  struct Frame {
+    std::shared_ptr<CodeObject> code;
+    std::size_t pc;
+    ScopePtr scope;
+    std::size_t stack_base;
+  };
+
+  ObjectPtr<> execute();
+
+  ObjectPtr<> load_global(GlobalCache& cache, Scope* scope, SymbolId name);
+
+  void prepare_call(Frame& frame, const Instruction& instruction);
+  void call_macro(Frame& frame, const Instruction& instruction);
+  void call_callable(Frame& frame, std::size_t args_count, bool tail);
+
+  std::vector<ObjectPtr<>> stack_;
+  std::vector<Frame> frames_;
+};
+
+} // lispp
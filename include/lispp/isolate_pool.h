@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <lispp/virtual_machine.h>
+
+namespace lispp {
+
+// NOTE: Isolate model. A VM with everything created by it is an isolate:
+//       its objects and scopes are refcounted non-atomically and are
+//       bound to the thread which created the VM (the cycle collector and
+//       the release queue are thread-local as well). Isolates share only
+//       immortal or immutable data: interned symbols, small numbers,
+//       booleans, builtins and the frozen base scope with the stdlibs
+//       (see get_base_scope). So independent VMs may run on different
+//       threads in parallel, but objects must not be passed between them
+//       (except the parsed data, see ParallelParser).
+//
+//       IsolatePool runs tasks on a fixed set of worker threads, each task
+//       in a new VM. Results must not refer to objects of the isolate.
+//       Every worker has its own queue: tasks submitted by a worker go to
+//       its queue, others are spread round-robin. Idle workers steal tasks
+//       from the other queues, so long tasks don't hold the short ones
+class IsolatePool {
+public:
+  // NOTE: 0 means the number of hardware threads
+  explicit IsolatePool(std::size_t threads_count = 0);
+  // NOTE: runs the queued tasks before joining the workers
+  ~IsolatePool();
+  IsolatePool(const IsolatePool&) = delete;
+  IsolatePool& operator=(const IsolatePool&) = delete;
+
+  // NOTE: task is called as task(VirtualMachine<>&). Exceptions of the
+  //       task are rethrown by the future
+  template<typename Task>
+  std::future<typename std::result_of<Task(VirtualMachine<>&)>::type>
+  submit(Task task) {
+    using Result = typename std::result_of<Task(VirtualMachine<>&)>::type;
+    auto packaged_task =
+        std::make_shared<std::packaged_task<Result(VirtualMachine<>&)>>(
+            std::move(task));
+    auto result = packaged_task->get_future();
+    push_task([packaged_task](VirtualMachine<>& vm) { (*packaged_task)(vm); });
+    return result;
+  }
+
+  // NOTE: evaluates all the forms of the code, the result is the last
+  //       value printed ("()" for nil)
+  std::future<std::string> eval(const std::string& code);
+
+  std::size_t get_threads_count() const { return workers_.size(); }
+
+  // NOTE: true if it's called by a task of the pool. Such tasks must not
+  //       wait for other tasks of the pool: all the workers may be waiting
+  bool is_current_worker() const;
+
+  // NOTE: number of tasks taken from the queues of other workers
+  std::size_t get_steals_count() const { return steals_count_; }
+
+private:
+  using IsolatedTask = std::function<void(VirtualMachine<>&)>;
+
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<IsolatedTask> tasks;
+  };
+
+  void push_task(IsolatedTask task);
+  // NOTE: takes the oldest task of the own queue or steals the newest
+  //       one of another queue
+  bool pop_task(std::size_t worker_index, IsolatedTask* task);
+  void run_worker(std::size_t worker_index);
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::atomic<std::size_t> next_queue_{0};
+  std::atomic<std::size_t> steals_count_{0};
+
+  std::mutex mutex_;
+  std::condition_variable has_tasks_;
+  std::size_t pending_count_ = 0;
+  bool stopping_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+} // lispp
@@ -2,6 +2,7 @@
 
 #include <vector>
 
+#include <lispp/args_span.h>
 #include <lispp/object.h>
 #include <lispp/cons_object.h>
 #include <lispp/object_ptr.h>
@@ -53,9 +54,8 @@ constexpr int kInfiniteValuesNum = -1;
 ObjectPtr<> unpack_list(const ObjectPtr<>& lst, int num_values,
                         std::vector<ObjectPtr<>>* result);
 
-ObjectPtr<> pack_list(const std::vector<ObjectPtr<>>& lst,
-                      const ObjectPtr<>& rest);
+ObjectPtr<> pack_list(ArgsSpan lst, const ObjectPtr<>& rest);
 
-ObjectPtr<> pack_list(const std::vector<ObjectPtr<>>& lst);
+ObjectPtr<> pack_list(ArgsSpan lst);
 
 } // lispp
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <sstream>
+
 #include <lispp/object.h>
+#include <lispp/object_pool.h>
 
 namespace lispp {
 
@@ -14,8 +17,23 @@ public:
     return "number";
   }
 
+  // NOTE: allocated from ObjectPool
+  static void* operator new(std::size_t size) {
+    return ObjectPool::allocate(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    ObjectPool::deallocate(ptr, size);
+  }
+
+  // NOTE: Small integers are preallocated immortal objects, so arithmetic
+  //       on them neither allocates nor touches ref counters.
+  //       Numbers are immutable to be shared.
+  static constexpr int kSmallIntegerMin = -128;
+  static constexpr int kSmallIntegerMax = 1023;
+
+  static ObjectPtr<NumberObject> make(double value);
+
   double get_value() const { return value_; }
-  void set_value(double value) { value_ = value; }
 
   NumberObject* as_number() override { return this; }
   const NumberObject* as_number() const override { return this; }
@@ -31,7 +49,7 @@ public:
     return ss.str();
   }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>&) override { return this; }
+  ObjectPtr<> eval(const ScopePtr&) override { return this; }
 
 protected:
   double value_ = 0;
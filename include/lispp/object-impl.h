@@ -4,6 +4,31 @@
 
 namespace lispp {
 
+// NOTE: ref/unref are inlined: they are called on every ObjectPtr copy
+inline int Object::ref() {
+  if (immortal_) {
+    return ref_count_;
+  }
+  return ++ref_count_;
+}
+
+inline int Object::unref() {
+  const int result = unref_nodelete();
+  if (result == 0 && !immortal_) {
+    destroy();
+  }
+  return result;
+}
+
+inline int Object::unref_nodelete() {
+  if (immortal_) {
+    return ref_count_;
+  }
+
+  assert(ref_count_ > 0);
+  return --ref_count_;
+}
+
 template<typename ObjectType>
 inline ObjectType* Object::as() {
   return dynamic_cast<ObjectType*>(this);
@@ -12,6 +12,7 @@
 namespace lispp {
 
 class Scope;
+class ReferenceVisitor;
 
 class ExecutionError : public std::runtime_error {
 public:
@@ -50,6 +51,17 @@ public:
 
   int get_ref_count() const;
 
+  // NOTE: Immortal objects are shared (caches, interned values) and never
+  //       deleted: ref/unref don't touch their counters
+  bool is_immortal() const { return immortal_; }
+  // NOTE: shared objects (e.g. symbols loaded by stdlib images) are not
+  //       written again: other threads read their flags
+  void make_immortal() {
+    if (!immortal_) {
+      immortal_ = true;
+    }
+  }
+
   // NOTE: Fast casters
   virtual BooleanObject* as_boolean() { return nullptr; }
   virtual const BooleanObject* as_boolean() const { return nullptr; }
@@ -80,15 +92,27 @@ public:
   virtual bool operator!=(const Object& other) const { return *this != other; }
 
   virtual std::string to_string() const = 0;
-  virtual ObjectPtr<> eval(const std::shared_ptr<Scope>& scope) = 0;
+  virtual ObjectPtr<> eval(const ScopePtr& scope) = 0;
+
+  // NOTE: Owned references for CycleCollector. clear_references breaks
+  //       them when the object is a garbage
+  virtual void traverse(ReferenceVisitor&) const {}
+  virtual void clear_references() {}
 
 protected:
+  // NOTE: allows constant initialization of static immortal objects
+  constexpr explicit Object(bool immortal) : immortal_(immortal) {}
+
   int ref();
   int unref();
   int unref_nodelete();
 
 private:
+  // NOTE: out of line slow path of unref
+  void destroy();
+
   int ref_count_ = 0;
+  bool immortal_ = false;
 };
 
 std::ostream& operator<<(std::ostream& out, const Object& obj);
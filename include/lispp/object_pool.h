@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lispp {
+
+enum class ObjectAllocatorType {
+  kPool,
+  kSystem
+};
+
+// NOTE: Size-class pool for small fixed-size objects (conses, numbers,
+//       symbols, characters). Free lists are thread-local and filled from
+//       large slabs which are never returned to the system. Blocks may be
+//       freed by any thread.
+//       Pooled classes define operator new/delete through it (delete via
+//       Object* finds them by the virtual destructor).
+//       Free blocks are poisoned under AddressSanitizer, so it still
+//       catches use-after-free of objects.
+//       The allocator type is process-wide.
+class ObjectPool {
+public:
+  ObjectPool() = delete;
+
+  static void* allocate(std::size_t size);
+  static void deallocate(void* ptr, std::size_t size);
+
+  static ObjectAllocatorType get_allocator_type();
+  // NOTE: Switching back to the system allocator is possible only until
+  //       the first slab is allocated (returns false otherwise)
+  static bool set_allocator_type(ObjectAllocatorType type);
+};
+
+} // lispp
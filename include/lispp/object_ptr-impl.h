@@ -193,7 +193,7 @@ bool ObjectPtr<ObjectType>::safe_equal(
 
 template<typename ObjectType>
 ObjectPtr<> ObjectPtr<ObjectType>::safe_eval(
-    const std::shared_ptr<Scope>& scope) const {
+    const ScopePtr& scope) const {
   if (!valid()) {
     throw ExecutionError("Cannot execute empty list!");
   }
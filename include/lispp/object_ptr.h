@@ -70,7 +70,7 @@ public:
   void swap(ObjectPtr& other);
 
   bool safe_equal(const ObjectPtr& other) const;
-  ObjectPtr<> safe_eval(const std::shared_ptr<Scope>& scope) const;
+  ObjectPtr<> safe_eval(const ObjectPtr<Scope>& scope) const;
   template<typename OtherType>
   ObjectPtr<OtherType> safe_cast() const;
 
@@ -78,6 +78,9 @@ private:
   ObjectType* ptr_ = nullptr;
 };
 
+// NOTE: Scopes are refcounted intrusively the same way as objects
+using ScopePtr = ObjectPtr<Scope>;
+
 template<typename ObjectType>
 bool operator==(const ObjectType* left,
                 const ObjectPtr<ObjectType>& right);
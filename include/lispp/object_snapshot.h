@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <lispp/args_span.h>
+#include <lispp/bytecode.h>
+#include <lispp/callable_object.h>
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+#include <lispp/scope.h>
+
+namespace lispp {
+
+// NOTE: Deep copy of an object graph which doesn't belong to any isolate
+//       (see IsolatePool), the way to pass values between them. It's taken
+//       on the thread of the source isolate and restored as new objects of
+//       the isolate of the current thread. Restoring doesn't change the
+//       snapshot, so it may be restored by several threads at once.
+//       Closures are copied with their scopes and lambda templates (they
+//       are compiled again by the isolate). Immortal objects and frozen
+//       scopes are shared instead of being copied. Named values of scopes
+//       (globals) are copied only if their names occur in the copied
+//       objects. Shared structure and cycles are preserved
+class ObjectSnapshot {
+public:
+  ObjectSnapshot() = default;
+
+  // NOTE: throws ExecutionError for objects which can't be copied
+  //       (builtins which are not immortal)
+  static ObjectSnapshot take(ArgsSpan roots);
+
+  std::vector<ObjectPtr<>> restore() const;
+
+  std::size_t get_roots_count() const { return roots_.size(); }
+
+private:
+  enum class NodeType {
+    kShared,
+    kFrozenScope,
+    kNumber,
+    kCharacters,
+    kCons,
+    kQuote,
+    kComma,
+    kBackTick,
+    kScope,
+    kLambdaTemplate,
+    kCompiledCallable,
+    kUserCallable
+  };
+
+  // NOTE: children are indices of nodes (kNil for nil):
+  //       cons - car and cdr, quote/comma/back tick - value,
+  //       scope - parent followed by slots,
+  //       lambda template - body forms,
+  //       compiled callable - lambda template and closure,
+  //       user callable - closure followed by body forms
+  struct Node {
+    explicit Node(NodeType type) : type(type) {}
+
+    NodeType type;
+    double number_value = 0;
+    std::string string_value;
+    Object* shared_object = nullptr;
+    Scope* frozen_scope = nullptr;
+    const SlotNames* slot_names = nullptr;
+    CallableType callable_type = CallableType::kFunction;
+    std::vector<SymbolId> args;
+    std::string rest_arg_name;
+    // NOTE: lambda template without body and code
+    std::shared_ptr<LambdaTemplate> lambda;
+
+    std::vector<std::size_t> children;
+    std::vector<std::pair<SymbolId, std::size_t>> named_values;
+  };
+
+  static constexpr std::size_t kNil = ~std::size_t(0);
+
+  class Builder;
+  class Restorer;
+
+  std::vector<Node> nodes_;
+  std::vector<std::size_t> roots_;
+};
+
+} // lispp
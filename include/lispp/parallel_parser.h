@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#include <lispp/isolate_pool.h>
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+
+namespace lispp {
+
+// NOTE: Parses all the top level forms of a text in parallel. A pre-scan
+//       (of brackets and strings only, without tokenizing) splits the text
+//       into chunks of whole forms, the chunks are parsed by the pool (the
+//       first one by the caller) and the forms are passed on in the order
+//       of the text.
+//       Parsed data (conses, numbers, strings, quotes and immortal symbols)
+//       isn't bound to an isolate: it isn't tracked by the cycle collector
+//       and pooled blocks may be freed by any thread. So the forms built by
+//       a worker are handed over to the caller with their only references
+class ParallelParser {
+public:
+  static constexpr std::size_t kDefaultChunkSize = 1 << 20;
+  // NOTE: chunks which may be parsed ahead of the handled ones
+  static constexpr std::size_t kChunksPerWorker = 4;
+
+  using FormHandler = std::function<void(const ObjectPtr<>& form)>;
+
+  explicit ParallelParser(IsolatePool* pool,
+                          std::size_t chunk_size = kDefaultChunkSize);
+
+  // NOTE: Passes the forms to the handler as soon as their chunk is
+  //       parsed, so handling overlaps parsing of the next chunks. Syntax
+  //       errors are thrown after the forms before them are handled, as
+  //       they are by sequential parsing. The text must not change until
+  //       it returns. Calls made by the pool itself are sequential
+  void parse_all(const char* data, std::size_t size,
+                 const FormHandler& handler);
+  std::vector<ObjectPtr<>> parse_all(const char* data, std::size_t size);
+
+  // NOTE: line reached by the handled forms (the line of the syntax error
+  //       after it's thrown), counted from 0 as by tokenizers
+  int get_current_line() const { return current_line_; }
+
+private:
+  struct Chunk {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    int first_line = 0;
+  };
+
+  struct ChunkResult {
+    std::vector<ObjectPtr<>> forms;
+    // NOTE: the line after the chunk or of its error
+    int end_line = 0;
+    std::exception_ptr error;
+  };
+
+  static std::vector<Chunk> split(const char* data, std::size_t size,
+                                  std::size_t chunk_size);
+  static ChunkResult parse_chunk(const char* data, const Chunk& chunk);
+  void handle_result(ChunkResult* result, const FormHandler& handler);
+
+  IsolatePool* pool_;
+  std::size_t chunk_size_;
+  int current_line_ = 0;
+};
+
+} // lispp
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
+#include <lispp/cons_object.h>
 #include <lispp/object.h>
 #include <lispp/tokenizer.h>
 #include <lispp/object_ptr.h>
@@ -21,11 +23,36 @@ public:
   ObjectPtr<> parse_object();
 
 private:
-  ObjectPtr<ConsObject> parse_begun_list();
+  // NOTE: Objects are parsed iteratively, the frames of the unfinished
+  //       lists and quotes are kept on the explicit stack, so neither
+  //       nesting nor length of lists is limited by the C++ stack
+  struct Frame {
+    enum class Type {
+      kList,
+      kListTail, // after the dot of the list
+      kQuote,
+      kComma,
+      kBackTick
+    };
+
+    explicit Frame(Type type) : type(type) {}
+
+    Type type;
+    // NOTE: lists are built by appending to the tail
+    ObjectPtr<ConsObject> head;
+    ConsObject* tail = nullptr;
+  };
+
+  // NOTE: returns true if the object is read and false if a frame is begun
+  bool read_object(ObjectPtr<>* object);
+  // NOTE: returns true if the frame is finished
+  bool add_to_frame(Frame* frame, ObjectPtr<>* object);
   void expect_token(const Token& tok, bool extract = true);
   void skip_endlines();
 
   ITokenizer* tokenizer_;
+  // NOTE: is kept between the calls to reuse the memory
+  std::vector<Frame> frames_;
 };
 
 } // lispp
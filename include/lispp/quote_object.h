@@ -1,5 +1,6 @@
 #pragma once
 
+#include <lispp/cycle_collector.h>
 #include <lispp/object.h>
 #include <lispp/object_ptr.h>
 
@@ -22,6 +23,11 @@ public:
   QuoteObject* as_quote() override { return this; }
   const QuoteObject* as_quote() const override { return this; }
 
+  void traverse(ReferenceVisitor& visitor) const override {
+    visitor.visit(value_);
+  }
+  void clear_references() override { value_.reset(); }
+
   bool operator==(const Object& other) const override {
     const auto* other_quote = other.as_quote();
     return (other_quote != nullptr && value_.safe_equal(other_quote->value_));
@@ -31,7 +37,7 @@ public:
     return "(quote " + (value_.valid() ? value_->to_string() : "nil") + ")";
   }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>&) override {
+  ObjectPtr<> eval(const ScopePtr&) override {
     return value_;
   }
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+namespace lispp {
+
+class Object;
+
+// NOTE: Deletes objects whose last reference is dropped. Objects released
+//       while another object is being deleted (its members) are queued
+//       instead of being deleted recursively, so dropping a long list or
+//       a deep structure takes constant native stack.
+//       The queue is thread-local. With a budget, a release deletes at most
+//       budget objects and leaves the rest pending: they are deleted by the
+//       next releases, by drain or at the thread exit.
+class ReleaseQueue {
+public:
+  static constexpr std::size_t kUnlimitedBudget = 0;
+
+  ReleaseQueue() = delete;
+
+  static void release(Object* object);
+
+  // NOTE: returns the number of deleted objects
+  static std::size_t drain(std::size_t budget = kUnlimitedBudget);
+
+  static std::size_t get_pending_count();
+
+  static std::size_t get_budget();
+  static void set_budget(std::size_t budget);
+};
+
+} // lispp
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cassert>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include <lispp/cycle_collector.h>
 #include <lispp/object.h>
+#include <lispp/object_pool.h>
 #include <lispp/object_ptr.h>
+#include <lispp/symbol_table.h>
 
 namespace lispp {
 
@@ -13,26 +20,195 @@ public:
   using runtime_error::runtime_error;
 };
 
-class Scope : public std::enable_shared_from_this<Scope> {
+// NOTE: Names of the slots of lexically addressed frames (lambda arguments
+//       or let variables). Shared by all the frames of the same lambda/let
+using SlotNames = std::vector<SymbolId>;
+
+// NOTE: Equal slot names share one instance which is never released, so
+//       frames refer to it by a raw pointer. Thread-safe
+std::shared_ptr<const SlotNames> intern_slot_names(const SlotNames& names);
+
+// NOTE: Environment frame. Refcounted intrusively (see ScopePtr), so it's
+//       bound to one thread as objects are.
+//       Slots are stored inline after the scope: frames are allocated by
+//       create_frame with the size of their layout from ObjectPool.
+//       The hash map of named values is created on the first define.
+//       Frozen scopes (see freeze) are immutable and never freed, so they
+//       may be shared by the global scopes of all VMs.
+class Scope final {
+  template<typename T>
+  friend class ObjectPtr;
+  friend class CycleCollector;
+
 public:
-  Scope() = default;
-  explicit Scope(const std::shared_ptr<Scope>& parent_scope);
+  Scope();
+  explicit Scope(const ScopePtr& parent_scope);
+  ~Scope();
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  static void* operator new(std::size_t size) {
+    return ObjectPool::allocate(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    ObjectPool::deallocate(ptr, size);
+  }
+
+  static ScopePtr create_frame(const ScopePtr& parent_scope,
+                               const SlotNames* slot_names);
+
+  int get_ref_count() const { return ref_count_; }
+
+  // NOTE: Makes the named values immortal and the scope immutable.
+  //       Assignments of its values by set! are copied to the child scope
+  //       the assignment is started from (copy-on-write), defines in it
+  //       throw. The scope must have no parent
+  void freeze();
+  bool is_frozen() const { return frozen_; }
 
+  bool has_value(SymbolId name) const;
   bool has_value(const std::string& name) const;
 
+  ObjectPtr<> get_value(SymbolId name);
   ObjectPtr<> get_value(const std::string& name);
+  void set_value(SymbolId name, const ObjectPtr<>& object);
   void set_value(const std::string& name, const ObjectPtr<>& object);
 
+  void replace_value(SymbolId name, const ObjectPtr<>& object);
   void replace_value(const std::string& name, const ObjectPtr<>& object);
 
+  // NOTE: Version of the named values of the versioned scopes under the
+  //       same root (the nearest ancestor without a mutable parent, e.g.
+  //       the global scope of a VM), see GlobalCache. Scopes passed by
+  //       get_versioned_value (or make_versioned) become versioned: any
+  //       later change of their named values (or their destruction) bumps
+  //       the version of their root. Versions are unique in the process, so
+  //       the version of a new root never matches the one of a freed root.
+  //       Never returns 0
+  std::uint64_t get_version() const { return version_root_->version_; }
+
+  // NOTE: Looks the name up as get_value does. Returns false if the value
+  //       is found in a slot (slots are not versioned)
+  bool get_versioned_value(SymbolId name, Object** value);
+  // NOTE: Makes the scope and its ancestors versioned. Returns false if
+  //       some of them have slots, so not all the changes bump the version
+  bool make_versioned();
+
+  // NOTE: Lexical addressing (see Compiler). Slots are also accessible
+  //       by their names with the methods above
+  Scope* get_ancestor(std::size_t depth) {
+    Scope* scope = this;
+    for (; depth > 0; --depth) {
+      scope = scope->parent_scope_.get();
+    }
+    return scope;
+  }
+
+  const ObjectPtr<>& get_slot(std::size_t slot) const {
+    assert(slot < slots_count_);
+    return get_slots()[slot];
+  }
+
+  void set_slot(std::size_t slot, ObjectPtr<> object) {
+    assert(slot < slots_count_);
+    get_slots()[slot] = std::move(object);
+  }
+
+  std::size_t get_slots_count() const { return slots_count_; }
+  // NOTE: nullptr for scopes without slots
+  const SlotNames* get_slot_names() const { return slot_names_; }
+
+  // NOTE: calls fn(SymbolId, const ObjectPtr<>&) for values which are not
+  //       in slots
+  template<typename Callable>
+  void for_each_named_value(Callable fn) const {
+    if (scope_) {
+      for (const auto& value : *scope_) {
+        fn(value.first, value.second);
+      }
+    }
+  }
+
   bool has_parent_scope() const;
-  std::shared_ptr<Scope> get_parent_scope();
+  ScopePtr get_parent_scope();
 
-  std::shared_ptr<Scope> create_child_scope();
+  ScopePtr create_child_scope();
 
-protected:
-  std::unordered_map<std::string, ObjectPtr<>> scope_;
-  std::shared_ptr<Scope> parent_scope_;
+  // NOTE: see CycleCollector
+  void traverse(ReferenceVisitor& visitor) const;
+  void clear();
+
+private:
+  using Values = std::unordered_map<SymbolId, ObjectPtr<>>;
+
+  Scope(const ScopePtr& parent_scope, const SlotNames* slot_names);
+
+  int ref() {
+    if (frozen_) {
+      return ref_count_;
+    }
+    return ++ref_count_;
+  }
+  int unref() {
+    const int result = unref_nodelete();
+    if (result == 0 && !frozen_) {
+      destroy();
+    }
+    return result;
+  }
+  int unref_nodelete() {
+    if (frozen_) {
+      return ref_count_;
+    }
+
+    assert(ref_count_ > 0);
+    return --ref_count_;
+  }
+
+  // NOTE: out of line slow path of unref. Releases the chain of parents
+  //       iteratively
+  void destroy();
+
+  std::size_t get_allocation_size() const {
+    return sizeof(Scope) + slots_count_ * sizeof(ObjectPtr<>);
+  }
+
+  ObjectPtr<>* get_slots() {
+    return reinterpret_cast<ObjectPtr<>*>(this + 1);
+  }
+  const ObjectPtr<>* get_slots() const {
+    return reinterpret_cast<const ObjectPtr<>*>(this + 1);
+  }
+
+  // NOTE: returns -1 if there is no slot with the name
+  int find_slot(SymbolId name) const;
+
+  void check_not_frozen(SymbolId name) const;
+
+  void init_version();
+  void bump_version() {
+    if (versioned_) {
+      version_root_->version_ = make_version();
+    }
+  }
+
+  static std::uint64_t make_version();
+
+  int ref_count_ = 0;
+  std::uint32_t slots_count_ : 30;
+  std::uint32_t versioned_ : 1;
+  std::uint32_t frozen_ : 1;
+  ScopePtr parent_scope_;
+  const SlotNames* slot_names_ = nullptr;
+  std::unique_ptr<Values> scope_;
+  // NOTE: the root keeps its own version
+  Scope* version_root_ = this;
+  std::uint64_t version_ = 0;
+
+  CycleCollectorLink collector_link_;
 };
 
+static_assert(sizeof(Scope) % alignof(ObjectPtr<>) == 0,
+              "Slots must be aligned");
+
 } // lispp
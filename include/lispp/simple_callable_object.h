@@ -15,8 +15,12 @@ public:
       : CallableObject(type, create_separate_scope), callable_(callable) {}
 
 protected:
-  ObjectPtr<> execute_impl(const std::shared_ptr<Scope>& scope,
-                       const std::vector<ObjectPtr<>>& args) override {
+  // NOTE: callable may return either ObjectPtr<> or TailResult
+  ObjectPtr<> execute_impl(const ScopePtr& scope, ArgsSpan args) override {
+    return run_trampoline(callable_(scope, args));
+  }
+
+  TailResult execute_tail_impl(const ScopePtr& scope, ArgsSpan args) override {
     return callable_(scope, args);
   }
 
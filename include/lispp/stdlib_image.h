@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <lispp/object.h>
+#include <lispp/object_ptr.h>
+
+namespace lispp {
+
+enum class ImageNodeType {
+  kNil,
+  kTrue,
+  kFalse,
+  kNumber,
+  kCharacters,
+  kSymbol,
+  kCons,      // pops cdr and car
+  kQuote,     // pops quoted value
+  kComma,
+  kBackTick
+};
+
+struct ImageNode {
+  ImageNodeType type;
+  double number_value;
+  const char* string_value;
+};
+
+// NOTE: Stdlib module parsed at build time (see tools/stdlib_cpp_gen.py).
+//       Nodes are the forms of the module in postfix order, so loading
+//       needs neither tokenizer nor parser
+struct StdlibImage {
+  const ImageNode* nodes;
+  std::size_t nodes_count;
+};
+
+// NOTE: returns the top-level forms of the module. Built objects are
+//       immortal, so the forms can be shared by all VMs
+std::vector<ObjectPtr<>> load_stdlib_image(const StdlibImage& image);
+
+} // lispp
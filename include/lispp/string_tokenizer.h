@@ -2,16 +2,17 @@
 
 #include <sstream>
 
-#include <lispp/istream_tokenizer.h>
+#include <lispp/buffer_tokenizer.h>
 
 namespace lispp {
 
-class StringTokenizer : public IstreamTokenizer {
+class StringTokenizer : public BufferTokenizer {
 public:
   StringTokenizer();
   StringTokenizer(const std::string& initial_value);
 
   void append(const std::string& initial_value);
+  // NOTE: drops the rest of the input
   void clear() override;
 
   StringTokenizer& operator<<(const std::string& value) {
@@ -29,7 +30,7 @@ public:
   }
 
 private:
-  std::stringstream input_ss_;
+  std::string buffer_;
 };
 
 } // lispp
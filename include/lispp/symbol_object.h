@@ -3,42 +3,67 @@
 #include <string>
 
 #include <lispp/object.h>
+#include <lispp/object_pool.h>
 #include <lispp/scope.h>
+#include <lispp/symbol_table.h>
 
 namespace lispp {
 
 // FIXME: make common superclass for this and StringObject ?
+// NOTE: Symbols are interned (see SymbolTable): equal symbols have the same id
+//       and the parser produces canonical objects only
 class SymbolObject : public Object {
+  friend class SymbolTable;
+
 public:
-  SymbolObject() = default;
-  explicit SymbolObject(const std::string& value) : value_(value) {}
+  explicit SymbolObject(const std::string& value)
+      : value_(value), id_(SymbolTable::intern(value)) {}
   ~SymbolObject() {}
 
   static std::string GetTypeName() {
     return "symbol";
   }
 
+  // NOTE: allocated from ObjectPool
+  static void* operator new(std::size_t size) {
+    return ObjectPool::allocate(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    ObjectPool::deallocate(ptr, size);
+  }
+
+  static ObjectPtr<SymbolObject> intern(const std::string& value) {
+    return SymbolTable::intern_symbol(value.data(), value.size());
+  }
+  static ObjectPtr<SymbolObject> intern(const char* text, std::size_t size) {
+    return SymbolTable::intern_symbol(text, size);
+  }
+
   const std::string& get_value() const { return value_; }
-  void set_value(const std::string& value) { value_ = value; }
+  SymbolId get_id() const { return id_; }
 
   SymbolObject* as_symbol() override { return this; }
   const SymbolObject* as_symbol() const override { return this; }
 
   bool operator==(const Object& other) const override {
     const auto* other_identifier = other.as_symbol();
-    return (other_identifier != nullptr && other_identifier->value_ == value_);
+    return (other_identifier != nullptr && other_identifier->id_ == id_);
   }
 
   std::string to_string() const override {
     return value_;
   }
 
-  ObjectPtr<> eval(const std::shared_ptr<Scope>& scope) override {
-    return scope->get_value(value_);
+  ObjectPtr<> eval(const ScopePtr& scope) override {
+    return scope->get_value(id_);
   }
 
 protected:
-  std::string value_;
+  SymbolObject(const std::string& value, SymbolId id)
+      : value_(value), id_(id) {}
+
+  const std::string value_;
+  const SymbolId id_;
 };
 
 inline std::ostream& operator<<(std::ostream& out, const SymbolObject& obj) {
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <lispp/object.h>
+
+namespace lispp {
+
+class SymbolObject;
+
+using SymbolId = std::size_t;
+
+// NOTE: Process-wide intern table of symbol names. Each distinct name gets
+//       a stable id and one canonical SymbolObject. Names are never released.
+//       Canonical symbols are immortal. Thread-safe, lookups of the names
+//       known to the thread don't lock.
+class SymbolTable {
+public:
+  SymbolTable() = delete;
+
+  static SymbolId intern(const std::string& name);
+  // NOTE: interns the name and returns its canonical symbol in one lookup
+  //       without copying the name if it's interned already
+  static ObjectPtr<SymbolObject> intern_symbol(const char* name,
+                                               std::size_t size);
+
+  static const std::string& get_name(SymbolId id);
+  static ObjectPtr<SymbolObject> get_symbol(SymbolId id);
+
+private:
+  static SymbolObject* intern_shared_symbol(const char* name,
+                                            std::size_t size);
+};
+
+} // lispp
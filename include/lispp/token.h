@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
 namespace lispp {
 
@@ -22,22 +27,53 @@ enum class TokenType {
   kUndefined
 };
 
+class TokenizerError : public std::runtime_error {
+public:
+  using runtime_error::runtime_error;
+};
+
+// NOTE: Plain token which doesn't own anything. The text of symbols and
+//       strings is a view into the source buffer of the tokenizer (see
+//       ITokenizer for its lifetime), numbers are parsed by the tokenizer
 struct Token final {
   Token() = default;
-  explicit Token(TokenType type);
-  Token(TokenType type, double number_value);
-  Token(TokenType type, const std::string& string_value);
+  explicit Token(TokenType type) : type(type) {}
+  Token(TokenType type, double number_value)
+      : type(type), number_value(number_value) {}
+  // NOTE: the text must outlive the token
+  Token(TokenType type, const char* text)
+      : Token(type, text, std::char_traits<char>::length(text)) {}
+  Token(TokenType type, const char* text, std::size_t text_size)
+      : type(type), text_size(check_text_size(text_size)), text(text) {}
 
   bool operator==(const Token& other) const;
   bool operator!=(const Token& other) const;
 
-  TokenType type = TokenType::kUndefined;
+  bool text_equals(const char* other_text) const {
+    return text_size == std::char_traits<char>::length(other_text) &&
+           std::char_traits<char>::compare(text, other_text, text_size) == 0;
+  }
+
+  std::string get_text() const { return std::string(text, text_size); }
 
-  bool bool_value = false;
+  // NOTE: sizes are 32-bit to keep tokens small, longer texts are errors
+  static std::uint32_t check_text_size(std::size_t text_size) {
+    if (text_size > std::numeric_limits<std::uint32_t>::max()) {
+      throw TokenizerError("Token is too long: " + std::to_string(text_size) +
+                           " chars");
+    }
+    return static_cast<std::uint32_t>(text_size);
+  }
+
+  TokenType type = TokenType::kUndefined;
+  std::uint32_t text_size = 0;
   double number_value = 0.0;
-  std::string string_value;
+  const char* text = nullptr;
 };
 
+static_assert(std::is_trivially_copyable<Token>::value,
+              "Token must be copied as plain data");
+
 std::ostream& operator<<(std::ostream& out, const Token& token);
 
 } // lispp
@@ -7,18 +7,16 @@
 
 namespace lispp {
 
-class TokenizerError : public std::runtime_error {
-public:
-  using runtime_error::runtime_error;
-};
-
+// NOTE: Tokens are returned by reference to the tokenizer. The text of the
+//       current and the peeked tokens is valid until the next call of
+//       next_token (copy it with Token::get_text to keep it longer)
 class ITokenizer {
 public:
   virtual ~ITokenizer() = 0;
 
-  virtual Token next_token() = 0;
-  virtual Token current_token() = 0;
-  virtual Token peek_token() = 0;
+  virtual const Token& next_token() = 0;
+  virtual const Token& current_token() = 0;
+  virtual const Token& peek_token() = 0;
   virtual bool has_more_tokens() = 0;
 
   virtual int get_current_line() = 0;
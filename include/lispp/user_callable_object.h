@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include <lispp/callable_object.h>
@@ -7,25 +9,73 @@
 namespace lispp {
 
 // FIXME: naming
+// NOTE: Expansions of macroses with one expression in the body are
+//       memoized per call site (the args list of the call form), so the
+//       expansion is computed once and only the expanded code is evaluated
+//       afterwards. The body may read the values of the closure, so
+//       the expansions are dropped by any change of the named values under
+//       the root of the closure (see Scope::get_version), and macroses with
+//       slots in the closure are not memoized. Redefined macro is a new
+//       object, so its call sites are expanded again. Macroses with several
+//       expressions evaluate the intermediate expansions too and are not
+//       memoized
 class UserCallableObject : public CallableObject {
 public:
+  static constexpr std::size_t kMaxExpansionsCount = 4096;
+
   explicit UserCallableObject(const std::string& name,
-                              const std::vector<std::string>& args,
+                              const std::vector<SymbolId>& args,
                               const std::vector<ObjectPtr<>>& body,
-                              const std::shared_ptr<Scope>& closure,
+                              const ScopePtr& closure,
                               const std::string& rest_arg_name,
                               CallableType type = CallableType::kFunction);
 
+  ObjectPtr<> execute(const ScopePtr& scope,
+                      const ObjectPtr<>& args) override;
+  TailResult execute_tail(const ScopePtr& scope,
+                          const ObjectPtr<>& args) override;
+
+  std::size_t get_expansions_count() const { return expansions_.size(); }
+
+  const std::string& get_name() const { return name_; }
+  const std::vector<SymbolId>& get_args() const { return args_; }
+  const std::vector<ObjectPtr<>>& get_body() const { return body_; }
+  const ScopePtr& get_closure() const { return closure_; }
+  // NOTE: empty if there is no rest argument
+  std::string get_rest_arg_name() const {
+    return (has_rest_arg_ ? SymbolTable::get_name(rest_arg_name_) : "");
+  }
+
+  void traverse(ReferenceVisitor& visitor) const override;
+  void clear_references() override;
+
 protected:
-  ObjectPtr<> execute_impl(const std::shared_ptr<Scope>& scope,
-                           const std::vector<ObjectPtr<>>& args) override;
+  ObjectPtr<> execute_impl(const ScopePtr& scope, ArgsSpan args) override;
+  TailResult execute_tail_impl(const ScopePtr& scope, ArgsSpan args) override;
 
 private:
+  struct Expansion {
+    // NOTE: keeps the key alive
+    ObjectPtr<> args;
+    ObjectPtr<> expansion;
+    std::uint64_t version;
+  };
+
+  bool is_memoized_macro() const {
+    return get_type() == CallableType::kMacro && body_.size() == 1;
+  }
+
+  ObjectPtr<> expand(const ObjectPtr<>& args);
+  ScopePtr bind_args(ArgsSpan args) const;
+
   std::string name_;
-  std::vector<std::string> args_;
+  std::vector<SymbolId> args_;
   std::vector<ObjectPtr<>> body_;
-  std::shared_ptr<Scope> closure_;
-  std::string rest_arg_name_;
+  ScopePtr closure_;
+  bool has_rest_arg_;
+  SymbolId rest_arg_name_;
+
+  std::unordered_map<const Object*, Expansion> expansions_;
 };
 
 } // lispp
@@ -9,7 +9,7 @@ template<typename TokenizerType = StringTokenizer>
 class VirtualMachine : public VirtualMachineBase {
 public:
   template<typename... TokenizerArgs>
-  VirtualMachine(const std::shared_ptr<Scope>& global_scope,
+  VirtualMachine(const ScopePtr& global_scope,
                  const TokenizerArgs&... tokenizer_args)
       : VirtualMachineBase(global_scope, nullptr) {
     tokenizer_.reset(new TokenizerType(tokenizer_args...));
@@ -32,7 +32,7 @@ private:
 template<>
 class VirtualMachine<StringTokenizer> : public VirtualMachineBase {
 public:
-  VirtualMachine(const std::shared_ptr<Scope>& global_scope,
+  VirtualMachine(const ScopePtr& global_scope,
                  const std::string& initial_code = "")
       : VirtualMachineBase(global_scope, nullptr) {
     tokenizer_.reset(new StringTokenizer(initial_code));
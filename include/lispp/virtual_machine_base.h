@@ -1,5 +1,6 @@
 #pragma once
 
+#include <lispp/object_pool.h>
 #include <lispp/parser.h>
 #include <lispp/tokenizer.h>
 #include <lispp/scope.h>
@@ -11,13 +12,21 @@ public:
   ObjectPtr<> parse();
   ObjectPtr<> eval();
   ObjectPtr<> eval_all();
+  // NOTE: evaluates a form parsed elsewhere (see ParallelParser)
+  ObjectPtr<> eval_form(const ObjectPtr<>& form);
 
   Parser& get_parser();
-  std::shared_ptr<Scope> get_global_scope();
+  ScopePtr get_global_scope();
+
+  // NOTE: Chooses the allocator of pooled objects for the whole process,
+  //       not for this VM: all the VMs and threads share it. Should be
+  //       called before virtual machines are created
+  //       (see ObjectPool::set_allocator_type)
+  static bool set_process_object_allocator(ObjectAllocatorType type);
 
 protected:
   explicit VirtualMachineBase(ITokenizer* tokenizer);
-  VirtualMachineBase(const std::shared_ptr<Scope>& global_scope,
+  VirtualMachineBase(const ScopePtr& global_scope,
                      ITokenizer* tokenizer);
 
   void init(ITokenizer* tokenizer);
@@ -25,9 +34,11 @@ protected:
   ITokenizer* get_tokenizer_base();
 
 private:
+  ObjectPtr<> run(const ObjectPtr<>& form);
+
   ITokenizer* tokenizer_;
   std::unique_ptr<Parser> parser_;
-  std::shared_ptr<Scope> global_scope_;
+  ScopePtr global_scope_;
 };
 
 } // lispp
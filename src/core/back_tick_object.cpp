@@ -17,14 +17,14 @@ std::string BackTickObject::to_string() const {
   return "`" + (value_.valid() ? value_->to_string() : "nil");
 }
 
-ObjectPtr<> BackTickObject::eval(const std::shared_ptr<Scope>& scope) {
+ObjectPtr<> BackTickObject::eval(const ScopePtr& scope) {
   return map_list(
       value_,
       std::bind(process_object_on_eval, std::placeholders::_1, scope));
 }
 
 ObjectPtr<> BackTickObject::process_object_on_eval(
-    ObjectPtr<> object, const std::shared_ptr<Scope>& scope) {
+    ObjectPtr<> object, const ScopePtr& scope) {
   if (object == nullptr) {
     return nullptr;
   } else if (object->as_comma()) {
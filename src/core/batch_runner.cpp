@@ -0,0 +1,102 @@
+#include <lispp/batch_runner.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <lispp/builtins.h>
+#include <lispp/function_utils.h>
+
+namespace lispp {
+
+namespace {
+
+  // NOTE: redirects print of the isolate to the result
+  class OutputCapture {
+  public:
+    OutputCapture() { builtins::set_output_stream(&output_); }
+    ~OutputCapture() { builtins::set_output_stream(nullptr); }
+
+    std::string get_output() const { return output_.str(); }
+
+  private:
+    std::stringstream output_;
+  };
+
+  std::string read_file(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+      throw std::runtime_error("Cannot open file " + path);
+    }
+
+    std::stringstream content;
+    content << input.rdbuf();
+    return content.str();
+  }
+
+  std::string describe_error(VirtualMachine<>& vm) {
+    try {
+      throw;
+    } catch (const TokenizerError& e) {
+      return "TokenizerError at line " +
+             std::to_string(vm.get_tokenizer().get_current_line()) + ": " +
+             e.what();
+    } catch (const ParserError& e) {
+      return "ParserError at line " +
+             std::to_string(vm.get_tokenizer().get_current_line()) + ": " +
+             e.what();
+    } catch (const MacroArgumentsError& e) {
+      return std::string("MacroArgumentsError: ") + e.what();
+    } catch (const ExecutionError& e) {
+      return std::string("ExecutionError: ") + e.what();
+    } catch (const ScopeError& e) {
+      return std::string("ScopeError: ") + e.what();
+    } catch (const std::exception& e) {
+      return std::string("Unknown exception: ") + e.what();
+    } catch (...) {
+      return "Unknown error.";
+    }
+  }
+
+  BatchResult run_input(VirtualMachine<>& vm, const BatchInput& input) {
+    BatchResult result;
+    result.name = input.name;
+
+    OutputCapture capture;
+    try {
+      auto value = vm.eval_all(input.path.empty() ? input.code
+                                                  : read_file(input.path));
+      result.value = (value.valid() ? value->to_string() : "()");
+      result.succeeded = true;
+    } catch (...) {
+      result.error = describe_error(vm);
+    }
+    result.output = capture.get_output();
+
+    return result;
+  }
+
+} // namespace
+
+std::size_t run_batch(IsolatePool& pool, const std::vector<BatchInput>& inputs,
+                      const BatchResultHandler& handler) {
+  std::vector<std::future<BatchResult>> results;
+  results.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    results.push_back(pool.submit([input](VirtualMachine<>& vm) {
+      return run_input(vm, input);
+    }));
+  }
+
+  std::size_t failed_count = 0;
+  for (auto& future_result : results) {
+    const BatchResult result = future_result.get();
+    if (!result.succeeded) {
+      ++failed_count;
+    }
+    handler(result);
+  }
+
+  return failed_count;
+}
+
+} // lispp
@@ -0,0 +1,10 @@
+#include <lispp/boolean_object.h>
+
+namespace lispp {
+
+// NOTE: constant initialized, so they are valid before any dynamic
+//       initialization which may use them
+BooleanObject BooleanObject::true_object_(true);
+BooleanObject BooleanObject::false_object_(false);
+
+} // lispp
@@ -0,0 +1,216 @@
+#include <lispp/buffer_tokenizer.h>
+
+#include <algorithm>
+
+#include <lispp/char_classes.h>
+
+namespace lispp {
+
+namespace {
+
+  const char* skip_white_spaces(const char* begin, const char* end) {
+    return skip_class(begin, end, kWhiteSpace);
+  }
+
+  const char* skip_digits_ext(const char* begin, const char* end) {
+    return skip_class(begin, end, kDigitExt);
+  }
+
+} // namespace
+
+BufferTokenizer::BufferTokenizer(const char* data, std::size_t size) {
+  set_buffer(data, size);
+}
+
+BufferTokenizer::~BufferTokenizer() {}
+
+const Token& BufferTokenizer::next_token() {
+  peek_token();
+  current_token_ = next_token_;
+  next_token_ = Token();
+  return current_token_;
+}
+
+const Token& BufferTokenizer::peek_token() {
+  if (next_token_.type == TokenType::kUndefined ||
+      next_token_.type == TokenType::kEnd) {
+    next_token_ = parse_token();
+  }
+
+  return next_token_;
+}
+
+const Token& BufferTokenizer::current_token() {
+  return current_token_;
+}
+
+bool BufferTokenizer::has_more_tokens() {
+  token_begin_ = position_;
+  skip_while(skip_white_spaces);
+  token_begin_ = position_;
+  return ensure_chars(1);
+}
+
+int BufferTokenizer::get_current_line() {
+  return current_line_;
+}
+
+void BufferTokenizer::clear() {
+  next_token_ = Token();
+  current_token_ = Token();
+  position_ = size_;
+  token_begin_ = position_;
+}
+
+void BufferTokenizer::set_buffer(const char* data, std::size_t size,
+                                 std::size_t position) {
+  const std::size_t shift = position_ - position;
+  token_begin_ = (token_begin_ > shift ? token_begin_ - shift : 0);
+  for (Token* token : {&current_token_, &next_token_}) {
+    if (is_in_buffer(token->text)) {
+      token->text = data + (token->text - data_ - shift);
+    }
+  }
+
+  data_ = data;
+  size_ = size;
+  position_ = position;
+}
+
+std::size_t BufferTokenizer::get_consumed_count() const {
+  std::size_t result = token_begin_;
+  for (const Token* token : {&current_token_, &next_token_}) {
+    if (is_in_buffer(token->text)) {
+      result = std::min<std::size_t>(result, token->text - data_);
+    }
+  }
+
+  return result;
+}
+
+bool BufferTokenizer::refill(std::size_t) {
+  return false;
+}
+
+template<typename Scanner>
+void BufferTokenizer::skip_while(Scanner scanner) {
+  do {
+    position_ = scanner(data_ + position_, data_ + size_) - data_;
+  } while (position_ == size_ && ensure_chars(1));
+}
+
+Token BufferTokenizer::parse_token() {
+  token_begin_ = position_;
+  skip_while(skip_white_spaces);
+  token_begin_ = position_;
+
+  if (!ensure_chars(1)) {
+    return Token(TokenType::kEnd);
+  }
+
+  const char current_char = data_[position_];
+  if (current_char == '\n') {
+    ++position_;
+    ++current_line_;
+    return Token(TokenType::kEndLine);
+  } else if (current_char == '"') {
+    return parse_characters_token();
+  } else if (is_symbol_token_start(current_char)) {
+    return parse_symbol_token();
+  } else if (kCharClasses.is(current_char, kDigitExt)) {
+    return parse_number_token();
+  } else {
+    return parse_one_symbol_token();
+  }
+}
+
+Token BufferTokenizer::parse_characters_token() {
+  ++position_;
+  skip_while(skip_to_quotes);
+  if (position_ == size_) {
+    throw TokenizerError("Unexpected end of file on reading string");
+  }
+  ++position_;
+
+  return make_text_token(TokenType::kCharacters, 1, 1);
+}
+
+bool BufferTokenizer::is_symbol_token_start(char current_char) {
+  if (kCharClasses.is(current_char, kInitialOfSymbol)) {
+    return true;
+  }
+
+  return kCharClasses.is(current_char, kSign) &&
+      !(ensure_chars(2) && kCharClasses.is(data_[position_ + 1], kDigitExt));
+}
+
+Token BufferTokenizer::parse_symbol_token() {
+  skip_while(skip_symbol_chars);
+  Token token = make_text_token(TokenType::kSymbol);
+
+  if (kCharClasses.is(token.text[0], kSign) && token.text_size != 1) {
+    throw TokenizerError("Invalid identifier token '" + token.get_text() +
+                         "'");
+  }
+
+  return token;
+}
+
+Token BufferTokenizer::parse_number_token() {
+  skip_while(skip_digits_ext);
+  // NOTE: numbers are short, so the copy isn't allocated
+  std::string string_value = make_text_token(TokenType::kNumber).get_text();
+
+  if (string_value.find('+', 1) != std::string::npos ||
+      string_value.find('-', 1) != std::string::npos) {
+    throw TokenizerError("Invalid number token '" + string_value + "'");
+  }
+
+  if (string_value == ".") {
+    return Token(TokenType::kDot);
+  }
+
+  const auto dotpos = string_value.find('.');
+  if (string_value.find('.', dotpos + 1) == std::string::npos) {
+    return Token(TokenType::kNumber, std::stod(string_value));
+  }
+
+  throw TokenizerError("Invalid number token '" + string_value + "'");
+}
+
+Token BufferTokenizer::parse_one_symbol_token() {
+  const char current_char = data_[position_++];
+
+  switch (current_char) {
+    case ',':
+      return Token(TokenType::kComma);
+    case '`':
+      return Token(TokenType::kBackTick);
+    case '.':
+      return Token(TokenType::kDot);
+    case '\'':
+      return Token(TokenType::kQuote);
+    case '(':
+      return Token(TokenType::kOpenBracket);
+    case ')':
+      return Token(TokenType::kCloseBracket);
+    default:
+      break;
+  }
+
+  throw TokenizerError("Unexpected symbol: "
+                       "'" + std::string(1, current_char) + "'" +
+                       " (" + std::to_string(int(current_char)) + ")");
+}
+
+bool BufferTokenizer::ensure_chars(std::size_t count) {
+  while (size_ - position_ < count) {
+    if (!refill(get_consumed_count())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // lispp
@@ -1,20 +1,31 @@
 #include <lispp/builtins.h>
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
 #include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <vector>
 
 #include <lispp/objects_all.h>
 #include <lispp/list_utils.h>
 #include <lispp/scope.h>
+#include <lispp/stdlib_image.h>
 #include <lispp/function_utils.h>
 #include <lispp/user_callable_object.h>
-#include <lispp/virtual_machine.h>
+#include <lispp/compiler.h>
+#include <lispp/interpreter.h>
+#include <lispp/isolate_pool.h>
+#include <lispp/object_snapshot.h>
 
 // FIXME: how to split this code to several files?
 namespace lispp {
 namespace builtins {
 
-ObjectPtr<> cond_macro(const std::shared_ptr<Scope>& scope,
-                       const std::vector<ObjectPtr<>>& args) {
+TailResult cond_macro(const ScopePtr& scope, ArgsSpan args) {
   for (auto& branch : args) {
     auto cons_branch = arg_cast<ConsObject>(branch, "cond",
                                             kInvalidArgNumber,
@@ -25,15 +36,14 @@ ObjectPtr<> cond_macro(const std::shared_ptr<Scope>& scope,
     ObjectPtr<> action = unpacked_branch[1];
 
     if (is_true_condition(condition, scope)) {
-      return action->eval(scope);
+      return TailResult(action, scope);
     }
   }
 
-  return nullptr;
+  return TailResult();
 }
 
-ObjectPtr<> if_macro(const std::shared_ptr<Scope>& scope,
-                     const std::vector<ObjectPtr<>>& args) {
+TailResult if_macro(const ScopePtr& scope, ArgsSpan args) {
   // FiXME: Ya.context extects syntax error!
   // if (args.size() < 2 || args.size() > 3) {
   //   throw ParserError("if have invalid number of arguments");
@@ -42,65 +52,67 @@ ObjectPtr<> if_macro(const std::shared_ptr<Scope>& scope,
 
   ObjectPtr<> condition = args[0];
   if (is_true_condition(condition, scope)) {
-    return args[1].safe_eval(scope);
+    return TailResult(args[1], scope);
   } else if (args.size() == 3) {
-    return args[2].safe_eval(scope);
+    return TailResult(args[2], scope);
   } else {
-    return nullptr;
+    return TailResult();
   }
 }
 
-ObjectPtr<> quote_macro(const std::shared_ptr<Scope>&,
-                    const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> quote_macro(const ScopePtr&, ArgsSpan args) {
   check_args_count("quote", args.size(), 1, CallableType::kMacro);
 
   return args[0];
 }
 
-ObjectPtr<> eval_macro(const std::shared_ptr<Scope>& scope,
-                   const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> eval_macro(const ScopePtr& scope, ArgsSpan args) {
   check_args_count("eval", args.size(), 1, CallableType::kMacro);
 
   return args[0].safe_eval(scope).safe_eval(scope);
 }
 
-ObjectPtr<> not_macro(const std::shared_ptr<Scope>& scope,
-                  const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> not_macro(const ScopePtr& scope, ArgsSpan args) {
   check_args_count("not", args.size(), 1, CallableType::kFunction);
 
   bool condition_value = is_true_condition(args[0], scope);
-  return new BooleanObject(!condition_value);
+  return BooleanObject::make(!condition_value);
 }
 
-ObjectPtr<> or_macro(const std::shared_ptr<Scope>& scope,
-                 const std::vector<ObjectPtr<>>& args) {
-  ObjectPtr<> result(new BooleanObject(false));
-  for (std::size_t arg_index = 0;
-       arg_index < args.size() && !is_true_value(result);
-       ++arg_index) {
-    result = args[arg_index].safe_eval(scope);
+TailResult or_macro(const ScopePtr& scope, ArgsSpan args) {
+  if (args.empty()) {
+    return ObjectPtr<>(BooleanObject::make(false));
   }
 
-  return result;
+  for (std::size_t arg_index = 0; arg_index + 1 < args.size(); ++arg_index) {
+    auto result = args[arg_index].safe_eval(scope);
+    if (is_true_value(result)) {
+      return result;
+    }
+  }
+
+  return TailResult(args.back(), scope);
 }
 
-ObjectPtr<> and_macro(const std::shared_ptr<Scope>& scope,
-                  const std::vector<ObjectPtr<>>& args) {
-  ObjectPtr<> result(new BooleanObject(true));
-  for (std::size_t arg_index = 0;
-       arg_index < args.size() && is_true_value(result);
-       ++arg_index) {
-    result = args[arg_index].safe_eval(scope);
+TailResult and_macro(const ScopePtr& scope, ArgsSpan args) {
+  if (args.empty()) {
+    return ObjectPtr<>(BooleanObject::make(true));
   }
 
-  return result;
+  for (std::size_t arg_index = 0; arg_index + 1 < args.size(); ++arg_index) {
+    auto result = args[arg_index].safe_eval(scope);
+    if (!is_true_value(result)) {
+      return result;
+    }
+  }
+
+  return TailResult(args.back(), scope);
 }
 
-ObjectPtr<> let_macro(const std::shared_ptr<Scope>& scope,
-                  const std::vector<ObjectPtr<>>& args) {
+TailResult let_macro(const ScopePtr& scope, ArgsSpan args) {
   check_args_count("let", args.size(), 1, kInfiniteArgs, CallableType::kMacro);
 
-  std::shared_ptr<Scope> local_scope = std::make_shared<Scope>(scope);
+  ScopePtr local_scope = scope->create_child_scope();
   auto varlist = unpack_list(args[0]);
   for (std::size_t var_index = 0; var_index < varlist.size(); ++var_index) {
     auto var_info = unpack_list(varlist[var_index]);
@@ -113,21 +125,24 @@ ObjectPtr<> let_macro(const std::shared_ptr<Scope>& scope,
                                           CallableType::kMacro);
     ObjectPtr<> eval_result = var_info[1].safe_eval(scope);
 
-    local_scope->set_value(varname->get_value(), eval_result);
+    local_scope->set_value(varname->get_id(), eval_result);
   }
 
-  ObjectPtr<> result;
-  for (std::size_t expr_index = 1; expr_index < args.size(); ++expr_index) {
-    result = args[expr_index].safe_eval(local_scope);
+  if (args.size() == 1) {
+    return TailResult();
   }
 
-  return result;
+  for (std::size_t expr_index = 1; expr_index + 1 < args.size(); ++expr_index) {
+    args[expr_index].safe_eval(local_scope);
+  }
+
+  return TailResult(args.back(), local_scope);
 }
 
 namespace {
   void parse_callable_definition(const std::string& macro_name,
                                  ObjectPtr<> cons_args,
-                                 std::vector<std::string>* arg_names,
+                                 std::vector<SymbolId>* arg_names,
                                  std::string* rest_arg_name) {
     std::vector<ObjectPtr<>> arg_symbols;
     auto rest_arg = unpack_list_rest(cons_args, &arg_symbols);
@@ -135,7 +150,7 @@ namespace {
     for (std::size_t arg_index = 0; arg_index < arg_symbols.size(); ++arg_index) {
       auto sym_arg = arg_cast<SymbolObject>(arg_symbols[arg_index], macro_name,
                                             0, CallableType::kMacro);
-      arg_names->push_back(sym_arg->get_value());
+      arg_names->push_back(sym_arg->get_id());
     }
 
     if (rest_arg.valid()) {
@@ -148,8 +163,7 @@ namespace {
   }
 } // namespace
 
-ObjectPtr<> lambda_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> lambda_macro(const ScopePtr& scope, ArgsSpan args) {
   // FiXME: Ya.context extects syntax error!
   // if (args.size() < 2) {
   //   throw ParserError("lambda have invalid number of arguments");
@@ -157,24 +171,20 @@ ObjectPtr<> lambda_macro(const std::shared_ptr<Scope>& scope,
   check_args_count("lambda", args.size(), 2, kInfiniteArgs,
                    CallableType::kMacro);
 
-  std::vector<std::string> arg_names;
+  std::vector<SymbolId> arg_names;
   std::string rest_arg_name;
   parse_callable_definition("lambda", args[0], &arg_names, &rest_arg_name);
   std::vector<ObjectPtr<>> body(std::next(args.begin()), args.end());
 
-  static int lambda_number = 0;
-  std::stringstream name_ss;
-  name_ss << "<lambda#" << lambda_number++ << ">";
-
-  return new UserCallableObject(name_ss.str(), arg_names, body,
+  return new UserCallableObject(make_lambda_name(), arg_names, body,
                                 scope, rest_arg_name);
 }
 
 namespace {
 
   ObjectPtr<> define_callable(const std::string& macro_name,
-                              const std::shared_ptr<Scope>& scope,
-                              const std::vector<ObjectPtr<>>& args,
+                              const ScopePtr& scope,
+                              ArgsSpan args,
                               CallableType callable_type) {
     auto header = arg_cast<ConsObject>(args[0], macro_name, 0,
                                        CallableType::kMacro);
@@ -183,7 +193,7 @@ namespace {
         header->get_left_value(), macro_name, 0, CallableType::kMacro);
     auto function_args = header->get_right_value();
 
-    std::vector<std::string> arg_names;
+    std::vector<SymbolId> arg_names;
     std::string rest_arg_name;
     parse_callable_definition(macro_name, function_args,
                               &arg_names, &rest_arg_name);
@@ -194,14 +204,13 @@ namespace {
         function_name->get_value(), arg_names, body, scope,
         rest_arg_name, callable_type));
 
-    scope->set_value(function_name->get_value(), result);
+    scope->set_value(function_name->get_id(), result);
     return result;
   }
 
 } // namespace
 
-ObjectPtr<> define_macro(const std::shared_ptr<Scope>& scope,
-                     const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> define_macro(const ScopePtr& scope, ArgsSpan args) {
   // FiXME: Ya.context extects syntax error!
   // if (args.size() < 2) {
   //   throw ParserError("define have invalid number of arguments");
@@ -218,7 +227,7 @@ ObjectPtr<> define_macro(const std::shared_ptr<Scope>& scope,
     check_args_count("define", args.size(), 2, CallableType::kMacro);
 
     auto result = args[1].safe_eval(scope);
-    scope->set_value(varname_symbol->get_value(), result);
+    scope->set_value(varname_symbol->get_id(), result);
     return nullptr;
   } else {
     define_callable("define", scope, args, CallableType::kFunction);
@@ -226,8 +235,7 @@ ObjectPtr<> define_macro(const std::shared_ptr<Scope>& scope,
   }
 }
 
-ObjectPtr<> defmacro_macro(const std::shared_ptr<Scope>& scope,
-                       const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> defmacro_macro(const ScopePtr& scope, ArgsSpan args) {
   check_args_count("define-macro", args.size(), 1, kInfiniteArgs,
                    CallableType::kMacro);
 
@@ -235,8 +243,7 @@ ObjectPtr<> defmacro_macro(const std::shared_ptr<Scope>& scope,
   return nullptr;
 }
 
-ObjectPtr<> set_macro(const std::shared_ptr<Scope>& scope,
-                  const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> set_macro(const ScopePtr& scope, ArgsSpan args) {
   // FiXME: Ya.context extects syntax error!
   // if (args.size() != 2) {
   //   throw ParserError("set! have invalid number of arguments");
@@ -247,19 +254,18 @@ ObjectPtr<> set_macro(const std::shared_ptr<Scope>& scope,
                                          CallableType::kMacro);
 
   auto eval_result = args[1].safe_eval(scope);
-  scope->replace_value(sym_name->get_value(), eval_result);
+  scope->replace_value(sym_name->get_id(), eval_result);
 
   return nullptr;
 }
 
-ObjectPtr<> setcar_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> setcar_macro(const ScopePtr& scope, ArgsSpan args) {
   check_args_count("set-car!", args.size(), 2, CallableType::kMacro);
 
   auto sym_name = arg_cast<SymbolObject>(args[0], "set-car!", 0,
                                          CallableType::kMacro);
 
-  auto object = scope->get_value(sym_name->get_value()).safe_cast<ConsObject>();
+  auto object = scope->get_value(sym_name->get_id()).safe_cast<ConsObject>();
   if (!object.valid()) {
     throw ExecutionError("Variable of set-car! must be a cons");
   }
@@ -269,14 +275,13 @@ ObjectPtr<> setcar_macro(const std::shared_ptr<Scope>& scope,
   return object;
 }
 
-ObjectPtr<> setcdr_macro(const std::shared_ptr<Scope>& scope,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> setcdr_macro(const ScopePtr& scope, ArgsSpan args) {
   check_args_count("set-cdr!", args.size(), 2, CallableType::kMacro);
 
   auto sym_name = arg_cast<SymbolObject>(args[0], "set-cdr!", 0,
                                          CallableType::kMacro);
 
-  auto object = scope->get_value(sym_name->get_value()).safe_cast<ConsObject>();
+  auto object = scope->get_value(sym_name->get_id()).safe_cast<ConsObject>();
   if (!object.valid()) {
     throw ExecutionError("Variable of set-cdr! must be a cons");
   }
@@ -286,63 +291,404 @@ ObjectPtr<> setcdr_macro(const std::shared_ptr<Scope>& scope,
   return object;
 }
 
-ObjectPtr<> cons_function(const std::shared_ptr<Scope>&,
-                          const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> cons_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("cons", args.size(), 2, CallableType::kMacro);
 
   ObjectPtr<> result(new ConsObject(args[0], args[1]));
   return result;
 }
 
-ObjectPtr<> car_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> car_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("car", args.size(), 1, CallableType::kMacro);
 
   auto cons = arg_cast<ConsObject>(args[0], "car", 0);
   return cons->get_left_value();
 }
 
-ObjectPtr<> cdr_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> cdr_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("cdr", args.size(), 1, CallableType::kMacro);
 
   auto cons = arg_cast<ConsObject>(args[0], "cdr", 0);
   return cons->get_right_value();
 }
 
-ObjectPtr<> nullp_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args) {
+namespace {
+
+  // NOTE: Builds a list from head to tail in place (without reverse)
+  class ListBuilder {
+  public:
+    void push_back(const ObjectPtr<>& value) {
+      ObjectPtr<ConsObject> cons(new ConsObject(value));
+      if (tail_.valid()) {
+        tail_->set_right_value(cons);
+      } else {
+        head_ = cons;
+      }
+      tail_ = cons;
+    }
+
+    ObjectPtr<> finish(const ObjectPtr<>& rest = nullptr) {
+      if (!tail_.valid()) {
+        return rest;
+      }
+
+      tail_->set_right_value(rest);
+      return head_;
+    }
+
+  private:
+    ObjectPtr<> head_;
+    ObjectPtr<ConsObject> tail_;
+  };
+
+  // NOTE: calls fn for each element of the proper list lst
+  template<typename Callable>
+  void for_each_element(const ObjectPtr<>& lst, const std::string& name,
+                        int arg_number, Callable fn) {
+    ObjectPtr<> tail = lst;
+    while (tail.valid()) {
+      auto cons = arg_cast<ConsObject>(tail, name, arg_number);
+      fn(cons->get_left_value());
+      tail = cons->get_right_value();
+    }
+  }
+
+  ObjectPtr<> call_function(const ObjectPtr<CallableObject>& function,
+                            const ScopePtr& scope,
+                            const ObjectPtr<>& arg) {
+    return function->call(scope, ArgsSpan(&arg, 1));
+  }
+
+} // namespace
+
+ObjectPtr<> length_function(const ScopePtr&, ArgsSpan args) {
+  check_args_count("length", args.size(), 1);
+
+  std::size_t length = 0;
+  for_each_element(args[0], "length", 0, [&length](const ObjectPtr<>&) {
+    ++length;
+  });
+
+  return NumberObject::make(length);
+}
+
+ObjectPtr<> list_tail_function(const ScopePtr&, ArgsSpan args) {
+  check_args_count("list-tail", args.size(), 2);
+
+  double count = arg_cast<NumberObject>(args[1], "list-tail", 1)->get_value();
+  ObjectPtr<> tail = args[0];
+  for (; count != 0; count -= 1) {
+    tail = arg_cast<ConsObject>(tail, "list-tail", 0)->get_right_value();
+  }
+
+  return tail;
+}
+
+ObjectPtr<> append_function(const ScopePtr&, ArgsSpan args) {
+  check_args_count("append", args.size(), 2);
+
+  ListBuilder result;
+  for_each_element(args[0], "append", 0, [&result](const ObjectPtr<>& value) {
+    result.push_back(value);
+  });
+
+  return result.finish(args[1]);
+}
+
+ObjectPtr<> reverse_function(const ScopePtr&, ArgsSpan args) {
+  check_args_count("reverse", args.size(), 1);
+
+  ObjectPtr<> result;
+  for_each_element(args[0], "reverse", 0, [&result](const ObjectPtr<>& value) {
+    result = new ConsObject(value, result);
+  });
+
+  return result;
+}
+
+ObjectPtr<> map_function(const ScopePtr& scope, ArgsSpan args) {
+  check_args_count("map", args.size(), 2);
+
+  auto function = arg_cast<CallableObject>(args[0], "map", 0);
+  ListBuilder result;
+  for_each_element(args[1], "map", 1, [&](const ObjectPtr<>& value) {
+    result.push_back(call_function(function, scope, value));
+  });
+
+  return result.finish();
+}
+
+ObjectPtr<> filter_function(const ScopePtr& scope, ArgsSpan args) {
+  check_args_count("filter", args.size(), 2);
+
+  auto predicate = arg_cast<CallableObject>(args[0], "filter", 0);
+  ListBuilder result;
+  for_each_element(args[1], "filter", 1, [&](const ObjectPtr<>& value) {
+    if (is_true_value(call_function(predicate, scope, value))) {
+      result.push_back(value);
+    }
+  });
+
+  return result.finish();
+}
+
+ObjectPtr<> member_function(const ScopePtr&, ArgsSpan args) {
+  check_args_count("member", args.size(), 2);
+
+  // NOTE: compares with = as the Lisp definition does
+  ObjectPtr<> tail = args[1];
+  while (tail.valid()) {
+    auto cons = arg_cast<ConsObject>(tail, "member", 1);
+    auto value = arg_cast<NumberObject>(cons->get_left_value(), "=", 0);
+    auto expected = arg_cast<NumberObject>(args[0], "=", 1);
+    if (value->get_value() == expected->get_value()) {
+      return BooleanObject::make(true);
+    }
+    tail = cons->get_right_value();
+  }
+
+  return BooleanObject::make(false);
+}
+
+ObjectPtr<> foldr_function(const ScopePtr& scope, ArgsSpan args) {
+  check_args_count("foldr", args.size(), 2);
+
+  auto function = arg_cast<CallableObject>(args[0], "foldr", 0);
+  std::vector<ObjectPtr<>> values;
+  for_each_element(args[1], "foldr", 1, [&values](const ObjectPtr<>& value) {
+    values.push_back(value);
+  });
+
+  if (values.empty()) {
+    return nullptr;
+  }
+
+  ObjectPtr<> result = values.back();
+  for (auto it = std::next(values.rbegin()); it != values.rend(); ++it) {
+    ObjectPtr<> call_args[] = {*it, result};
+    result = function->call(scope, ArgsSpan(call_args, 2));
+  }
+
+  return result;
+}
+
+ObjectPtr<> make_list_function(const ScopePtr&, ArgsSpan args) {
+  check_args_count("make-list", args.size(), 2);
+
+  double count = arg_cast<NumberObject>(args[0], "make-list", 0)->get_value();
+  if (count < 0 || count != std::floor(count)) {
+    throw ExecutionError("make-list: size must be a non-negative integer");
+  }
+
+  ObjectPtr<> result;
+  for (; count != 0; count -= 1) {
+    result = new ConsObject(args[1], result);
+  }
+
+  return result;
+}
+
+namespace {
+
+  // NOTE: chunks per worker by default, so the workers may steal the
+  //       chunks of the slow ones
+  constexpr std::size_t kChunksPerWorker = 4;
+
+  IsolatePool& get_parallel_pool() {
+    static IsolatePool pool;
+    return pool;
+  }
+
+  // NOTE: Calls a copy of the function for copies of the values, so side
+  //       effects of the calls (set! of globals or of the captured
+  //       variables, mutation of the values) are never visible
+  std::vector<ObjectPtr<>> call_for_copies(const ObjectSnapshot& function,
+                                           const ObjectSnapshot& values,
+                                           const ScopePtr& scope,
+                                           bool need_results) {
+    auto function_copy = function.restore().front().safe_cast<CallableObject>();
+    std::vector<ObjectPtr<>> results;
+    for (const auto& value : values.restore()) {
+      auto result = call_function(function_copy, scope, value);
+      if (need_results) {
+        results.push_back(result);
+      }
+    }
+
+    return results;
+  }
+
+  struct ChunkResult {
+    ObjectSnapshot results;
+    std::string output;
+    std::exception_ptr error;
+  };
+
+  // NOTE: Calls a chunk on an isolate of the pool. Its output is kept, so
+  //       the caller prints it to its own stream in the order of the chunks
+  ChunkResult call_chunk(const ObjectSnapshot& function,
+                         const ObjectSnapshot& values, const ScopePtr& scope,
+                         bool need_results) {
+    ChunkResult result;
+    std::ostringstream output;
+    std::ostream* previous_output = &get_output_stream();
+    set_output_stream(&output);
+    try {
+      result.results = ObjectSnapshot::take(
+          call_for_copies(function, values, scope, need_results));
+    } catch (...) {
+      result.error = std::current_exception();
+    }
+    set_output_stream(previous_output);
+    result.output = output.str();
+
+    return result;
+  }
+
+  // NOTE: Calls the function for the elements of the list in chunks of
+  //       grain elements. The caller calls the function for the first
+  //       chunk, the others are called by isolates of the parallel pool.
+  //       All the calls are made with copies of the function and the
+  //       elements (see ObjectSnapshot). Returns the results in the order
+  //       of the elements if they are needed. Calls made by the pool itself
+  //       (nested ones) are sequential
+  std::vector<ObjectPtr<>> call_in_chunks(const std::string& name,
+                                          const ScopePtr& scope,
+                                          ArgsSpan args,
+                                          bool need_results) {
+    check_args_count(name, args.size(), 2, 3);
+
+    arg_cast<CallableObject>(args[0], name, 0);
+    std::vector<ObjectPtr<>> values;
+    for_each_element(args[1], name, 1, [&values](const ObjectPtr<>& value) {
+      values.push_back(value);
+    });
+
+    IsolatePool& pool = get_parallel_pool();
+    std::size_t grain = std::max<std::size_t>(
+        1, values.size() / (pool.get_threads_count() * kChunksPerWorker));
+    if (args.size() == 3) {
+      const double grain_value =
+          arg_cast<NumberObject>(args[2], name, 2)->get_value();
+      if (grain_value < 1 || grain_value != std::floor(grain_value)) {
+        throw ExecutionError(name + ": grain must be a positive integer");
+      }
+      // NOTE: greater grains are the same, but may not fit to size_t
+      grain = std::min<double>(
+          grain_value, std::max<std::size_t>(values.size(), 1));
+    }
+
+    auto function_snapshot = std::make_shared<ObjectSnapshot>(
+        ObjectSnapshot::take(ArgsSpan(args.data(), 1)));
+    auto take_chunk = [&values](std::size_t begin, std::size_t end) {
+      return std::make_shared<ObjectSnapshot>(ObjectSnapshot::take(
+          ArgsSpan(values.data() + begin, end - begin)));
+    };
+
+    if (values.size() <= grain || pool.is_current_worker()) {
+      return call_for_copies(*function_snapshot,
+                             *take_chunk(0, values.size()), scope,
+                             need_results);
+    }
+
+    std::vector<std::future<ChunkResult>> chunks;
+    for (std::size_t begin = grain; begin < values.size(); begin += grain) {
+      auto chunk = take_chunk(begin, std::min(begin + grain, values.size()));
+      chunks.push_back(pool.submit(
+          [function_snapshot, chunk, need_results](VirtualMachine<>& vm) {
+            return call_chunk(*function_snapshot, *chunk,
+                              vm.get_global_scope(), need_results);
+          }));
+    }
+
+    // NOTE: all the chunks are waited for even after an error: their
+    //       snapshots may refer to the objects of this isolate
+    std::vector<ObjectPtr<>> results;
+    std::exception_ptr error;
+    try {
+      results = call_for_copies(*function_snapshot, *take_chunk(0, grain),
+                                scope, need_results);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    // NOTE: the output after the first error is dropped, as it would be by
+    //       sequential calls
+    for (auto& chunk : chunks) {
+      try {
+        const ChunkResult chunk_result = chunk.get();
+        if (error) {
+          continue;
+        }
+
+        get_output_stream() << chunk_result.output;
+        if (chunk_result.error) {
+          std::rethrow_exception(chunk_result.error);
+        }
+        if (need_results) {
+          auto restored_results = chunk_result.results.restore();
+          results.insert(results.end(), restored_results.begin(),
+                         restored_results.end());
+        }
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+
+    return results;
+  }
+
+} // namespace
+
+ObjectPtr<> pmap_function(const ScopePtr& scope, ArgsSpan args) {
+  ListBuilder result;
+  for (const auto& value : call_in_chunks("pmap", scope, args, true)) {
+    result.push_back(value);
+  }
+
+  return result.finish();
+}
+
+ObjectPtr<> pfor_each_function(const ScopePtr& scope, ArgsSpan args) {
+  call_in_chunks("pfor-each", scope, args, false);
+
+  return nullptr;
+}
+
+ObjectPtr<> nullp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("null?", args.size(), 1);
 
-  return new BooleanObject(!args[0].valid());
+  return BooleanObject::make(!args[0].valid());
 }
 
-ObjectPtr<> numberp_function(const std::shared_ptr<Scope>&,
-                             const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> numberp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("number?", args.size(), 1);
 
   bool result_value = args[0].safe_cast<NumberObject>().valid();
-  return new BooleanObject(result_value);
+  return BooleanObject::make(result_value);
 }
 
-ObjectPtr<> booleanp_function(const std::shared_ptr<Scope>&,
-                              const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> booleanp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("boolean?", args.size(), 1);
 
   bool result_value = args[0].safe_cast<BooleanObject>().valid();
-  return new BooleanObject(result_value);
+  return BooleanObject::make(result_value);
 }
 
-ObjectPtr<> consp_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> consp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("cons?", args.size(), 1);
 
   bool result_value = args[0].safe_cast<ConsObject>().valid();
-  return new BooleanObject(result_value);
+  return BooleanObject::make(result_value);
 }
 
-ObjectPtr<> listp_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> listp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("list?", args.size(), 1);
 
   bool result = true;
@@ -355,27 +701,24 @@ ObjectPtr<> listp_function(const std::shared_ptr<Scope>&,
       result = false;
     }
   }
-  return new BooleanObject(result);
+  return BooleanObject::make(result);
 }
 
-ObjectPtr<> symbolp_function(const std::shared_ptr<Scope>&,
-                             const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> symbolp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("symbol?", args.size(), 1);
 
   bool result_value = args[0].safe_cast<SymbolObject>().valid();
-  return new BooleanObject(result_value);
+  return BooleanObject::make(result_value);
 }
 
-ObjectPtr<> stringp_function(const std::shared_ptr<Scope>&,
-                             const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> stringp_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("string?", args.size(), 1);
 
   bool result_value = args[0].safe_cast<CharactersObject>().valid();
-  return new BooleanObject(result_value);
+  return BooleanObject::make(result_value);
 }
 
-ObjectPtr<> plus_function(const std::shared_ptr<Scope>&,
-                          const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> plus_function(const ScopePtr&, ArgsSpan args) {
   double result = 0;
   for (std::size_t arg_index = 0; arg_index < args.size(); ++arg_index) {
     auto number = arg_cast<NumberObject>(args[arg_index], "+", arg_index);
@@ -383,11 +726,10 @@ ObjectPtr<> plus_function(const std::shared_ptr<Scope>&,
     result += number->get_value();
   }
 
-  return new NumberObject(result);
+  return NumberObject::make(result);
 }
 
-ObjectPtr<> minus_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> minus_function(const ScopePtr&, ArgsSpan args) {
   if (args.empty()) {
     throw ExecutionError("- requires at least one argument");
   }
@@ -396,7 +738,7 @@ ObjectPtr<> minus_function(const std::shared_ptr<Scope>&,
   double result = first_number->get_value();
 
   if (args.size() == 1) {
-    return new NumberObject(-result);
+    return NumberObject::make(-result);
   }
 
   for (std::size_t arg_index = 1; arg_index < args.size(); ++arg_index) {
@@ -405,11 +747,10 @@ ObjectPtr<> minus_function(const std::shared_ptr<Scope>&,
     result -= number->get_value();
   }
 
-  return new NumberObject(result);
+  return NumberObject::make(result);
 }
 
-ObjectPtr<> mul_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> mul_function(const ScopePtr&, ArgsSpan args) {
   double result = 1;
   for (std::size_t arg_index = 0; arg_index < args.size(); ++arg_index) {
     auto number = arg_cast<NumberObject>(args[arg_index], "*", arg_index);
@@ -417,11 +758,10 @@ ObjectPtr<> mul_function(const std::shared_ptr<Scope>&,
     result *= number->get_value();
   }
 
-  return new NumberObject(result);
+  return NumberObject::make(result);
 }
 
-ObjectPtr<> div_function(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> div_function(const ScopePtr&, ArgsSpan args) {
   if (args.empty()) {
     throw ExecutionError("/ requires at least one argument");
   }
@@ -430,7 +770,7 @@ ObjectPtr<> div_function(const std::shared_ptr<Scope>&,
   double result = first_number->get_value();
 
   if (args.size() == 1) {
-    return new NumberObject(1 / result);
+    return NumberObject::make(1 / result);
   }
 
   for (std::size_t arg_index = 1; arg_index < args.size(); ++arg_index) {
@@ -439,7 +779,7 @@ ObjectPtr<> div_function(const std::shared_ptr<Scope>&,
     result /= number->get_value();
   }
 
-  return new NumberObject(result);
+  return NumberObject::make(result);
 }
 
 // FIXME: move to header?
@@ -448,10 +788,9 @@ struct CompareFunc {
   CompareFunc(const std::string& comp_name)
       : comp_name(comp_name) {}
 
-  ObjectPtr<> operator()(const std::shared_ptr<Scope>&,
-                         const std::vector<ObjectPtr<>>& args) const {
+  ObjectPtr<> operator()(const ScopePtr&, ArgsSpan args) const {
     if (args.empty()) {
-      return new BooleanObject(true);
+      return BooleanObject::make(true);
     }
 
     check_args_count(comp_name, args.size(), 2, kInfiniteArgs);
@@ -471,36 +810,48 @@ struct CompareFunc {
       last_obj = curr_obj;
     }
 
-    return new BooleanObject(result);
+    return BooleanObject::make(result);
   }
 
   std::string comp_name;
 };
 
-ObjectPtr<> string_len_function(const std::shared_ptr<Scope>&,
-                                const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> string_len_function(const ScopePtr&, ArgsSpan args) {
   check_args_count("string-length", args.size(), 1);
   auto string = arg_cast<CharactersObject>(args[0], "string-length");
 
-  return new NumberObject(string->get_value().size());
+  return NumberObject::make(string->get_value().size());
+}
+
+namespace {
+
+  thread_local std::ostream* output_stream = &std::cout;
+
+} // namespace
+
+std::ostream& get_output_stream() {
+  return *output_stream;
+}
+
+void set_output_stream(std::ostream* out) {
+  output_stream = (out != nullptr ? out : &std::cout);
 }
 
-ObjectPtr<> print_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> print_function(const ScopePtr&, ArgsSpan args) {
+  std::ostream& out = get_output_stream();
   for (auto& object : args) {
     if (object.valid()) {
-      std::cout << *object;
+      out << *object;
     } else {
-      std::cout << "nil";
+      out << "nil";
     }
-    std::cout << std::endl;
+    out << std::endl;
   }
 
   return nullptr;
 }
 
-ObjectPtr<> exit_function(const std::shared_ptr<Scope>&,
-                          const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> exit_function(const ScopePtr&, ArgsSpan args) {
   int code = 0;
   if (args.size() > 0) {
     auto number = args[0].safe_cast<NumberObject>();
@@ -514,8 +865,7 @@ ObjectPtr<> exit_function(const std::shared_ptr<Scope>&,
   return nullptr;
 }
 
-ObjectPtr<> throw_function(const std::shared_ptr<Scope>&,
-                           const std::vector<ObjectPtr<>>& args) {
+ObjectPtr<> throw_function(const ScopePtr&, ArgsSpan args) {
   std::stringstream ss;
   ss << "Throw from code: ";
   for (auto& arg : args) {
@@ -525,200 +875,293 @@ ObjectPtr<> throw_function(const std::shared_ptr<Scope>&,
   throw ExecutionError(ss.str());
 }
 
-extern const char* kBuiltinsStdlib_common;
+extern const StdlibImage kBuiltinsStdlib_common;
+extern const StdlibImage kBuiltinsStdlib_list;
 
 } // builtins
 
-void init_global_scope(const std::shared_ptr<Scope>& scope) {
+namespace {
+
+  // NOTE: builtins are shared by all isolates, so they are immortal
+  template<typename Callable>
+  ObjectPtr<CallableObject> make_builtin(
+      Callable callable, CallableType type = CallableType::kFunction,
+      bool create_separate_scope = false) {
+    ObjectPtr<CallableObject> result(make_simple_callable(
+        callable, type, create_separate_scope));
+    result->make_immortal();
+    return result;
+  }
+
+  template<typename Callable>
+  ObjectPtr<CallableObject> make_special_form(
+      Callable callable, SpecialForm special_form,
+      bool create_separate_scope = false) {
+    auto result = make_builtin(callable, CallableType::kMacro,
+                               create_separate_scope);
+    result->set_special_form(special_form);
+    return result;
+  }
+
+  void eval_forms(const ScopePtr& scope,
+                  const std::vector<ObjectPtr<>>& forms) {
+    for (const auto& form : forms) {
+      auto code = Compiler(scope).compile(form);
+      Interpreter().run(code, scope);
+    }
+  }
+
+} // namespace
+
+void init_global_scope(const ScopePtr& scope) {
   init_scope_with_builtins(scope);
   init_scope_with_stdlibs(scope);
 }
 
-void init_scope_with_builtins(const std::shared_ptr<Scope>& scope) {
+ScopePtr get_base_scope() {
+  static const ScopePtr base_scope = [] {
+    ScopePtr scope(new Scope);
+    init_global_scope(scope);
+    scope->freeze();
+    return scope;
+  }();
+
+  return base_scope;
+}
+
+void init_scope_with_builtins(const ScopePtr& scope) {
   using namespace builtins;
 
   // Built-in macro
   static ObjectPtr<CallableObject> cond(
-      make_simple_callable(cond_macro, CallableType::kMacro));
+      make_special_form(cond_macro, SpecialForm::kCond));
   scope->set_value("cond", cond);
 
   static ObjectPtr<CallableObject> if_(
-      make_simple_callable(if_macro, CallableType::kMacro));
+      make_special_form(if_macro, SpecialForm::kIf));
   scope->set_value("if", if_);
 
   static ObjectPtr<CallableObject> quote(
-      make_simple_callable(quote_macro, CallableType::kMacro));
+      make_special_form(quote_macro, SpecialForm::kQuote));
   scope->set_value("quote", quote);
 
   static ObjectPtr<CallableObject> eval(
-      make_simple_callable(eval_macro, CallableType::kMacro));
+      make_builtin(eval_macro, CallableType::kMacro));
   scope->set_value("eval", eval);
 
   static ObjectPtr<CallableObject> let(
-      make_simple_callable(let_macro, CallableType::kMacro, true));
+      make_special_form(let_macro, SpecialForm::kLet, true));
   scope->set_value("let", let);
 
   static ObjectPtr<CallableObject> lambda(
-      make_simple_callable(lambda_macro, CallableType::kMacro));
+      make_special_form(lambda_macro, SpecialForm::kLambda));
   scope->set_value("lambda", lambda);
 
   static ObjectPtr<CallableObject> define(
-      make_simple_callable(define_macro, CallableType::kMacro));
+      make_special_form(define_macro, SpecialForm::kDefine));
   scope->set_value("define", define);
 
   static ObjectPtr<CallableObject> defmacro(
-      make_simple_callable(defmacro_macro, CallableType::kMacro));
+      make_builtin(defmacro_macro, CallableType::kMacro));
   scope->set_value("define-macro", defmacro);
 
   static ObjectPtr<CallableObject> set_(
-      make_simple_callable(set_macro, CallableType::kMacro));
+      make_special_form(set_macro, SpecialForm::kSet));
   scope->set_value("set!", set_);
 
   static ObjectPtr<CallableObject> setcar(
-      make_simple_callable(setcar_macro, CallableType::kMacro));
+      make_builtin(setcar_macro, CallableType::kMacro));
   scope->set_value("set-car!", setcar);
 
   static ObjectPtr<CallableObject> setcdr(
-      make_simple_callable(setcdr_macro, CallableType::kMacro));
+      make_builtin(setcdr_macro, CallableType::kMacro));
   scope->set_value("set-cdr!", setcdr);
 
   // Boolean macroses
   static ObjectPtr<CallableObject> not_(
-      make_simple_callable(not_macro, CallableType::kMacro));
+      make_builtin(not_macro, CallableType::kMacro));
   scope->set_value("not", not_);
 
   static ObjectPtr<CallableObject> or_(
-      make_simple_callable(or_macro, CallableType::kMacro));
+      make_special_form(or_macro, SpecialForm::kOr));
   scope->set_value("or", or_);
 
   static ObjectPtr<CallableObject> and_(
-      make_simple_callable(and_macro, CallableType::kMacro));
+      make_special_form(and_macro, SpecialForm::kAnd));
   scope->set_value("and", and_);
 
   // List operators
-  static ObjectPtr<CallableObject> cons(make_simple_callable(cons_function));
+  static ObjectPtr<CallableObject> cons(make_builtin(cons_function));
   scope->set_value("cons", cons);
 
-  static ObjectPtr<CallableObject> car(make_simple_callable(car_function));
+  static ObjectPtr<CallableObject> car(make_builtin(car_function));
   scope->set_value("car", car);
 
-  static ObjectPtr<CallableObject> cdr(make_simple_callable(cdr_function));
+  static ObjectPtr<CallableObject> cdr(make_builtin(cdr_function));
   scope->set_value("cdr", cdr);
 
+  static ObjectPtr<CallableObject> length(
+      make_builtin(length_function));
+  scope->set_value("length", length);
+
+  static ObjectPtr<CallableObject> list_tail(
+      make_builtin(list_tail_function));
+  scope->set_value("list-tail", list_tail);
+
+  static ObjectPtr<CallableObject> append(
+      make_builtin(append_function));
+  scope->set_value("append", append);
+
+  static ObjectPtr<CallableObject> reverse(
+      make_builtin(reverse_function));
+  scope->set_value("reverse", reverse);
+
+  static ObjectPtr<CallableObject> map(make_builtin(map_function));
+  scope->set_value("map", map);
+
+  static ObjectPtr<CallableObject> filter(
+      make_builtin(filter_function));
+  scope->set_value("filter", filter);
+
+  static ObjectPtr<CallableObject> member(
+      make_builtin(member_function));
+  scope->set_value("member", member);
+
+  static ObjectPtr<CallableObject> foldr(make_builtin(foldr_function));
+  scope->set_value("foldr", foldr);
+
+  static ObjectPtr<CallableObject> make_list(
+      make_builtin(make_list_function));
+  scope->set_value("make-list", make_list);
+
+  static ObjectPtr<CallableObject> pmap(make_builtin(pmap_function));
+  scope->set_value("pmap", pmap);
+
+  static ObjectPtr<CallableObject> pfor_each(
+      make_builtin(pfor_each_function));
+  scope->set_value("pfor-each", pfor_each);
+
   // Built-in predicates
-  static ObjectPtr<CallableObject> nullp(make_simple_callable(nullp_function));
+  static ObjectPtr<CallableObject> nullp(make_builtin(nullp_function));
   scope->set_value("null?", nullp);
 
   static ObjectPtr<CallableObject> numberp(
-      make_simple_callable(numberp_function));
+      make_builtin(numberp_function));
   scope->set_value("number?", numberp);
 
   static ObjectPtr<CallableObject> booleanp(
-      make_simple_callable(booleanp_function));
+      make_builtin(booleanp_function));
   scope->set_value("boolean?", booleanp);
 
-  static ObjectPtr<CallableObject> consp(make_simple_callable(consp_function));
+  static ObjectPtr<CallableObject> consp(make_builtin(consp_function));
   scope->set_value("cons?", consp);
 
-  static ObjectPtr<CallableObject> listp(make_simple_callable(listp_function));
+  static ObjectPtr<CallableObject> listp(make_builtin(listp_function));
   scope->set_value("list?", listp);
 
   static ObjectPtr<CallableObject> symbolp(
-      make_simple_callable(symbolp_function));
+      make_builtin(symbolp_function));
   scope->set_value("symbol?", symbolp);
 
   static ObjectPtr<CallableObject> stringp(
-      make_simple_callable(stringp_function));
+      make_builtin(stringp_function));
   scope->set_value("string?", stringp);
 
   // Number operators
-  static ObjectPtr<CallableObject> plus(make_simple_callable(plus_function));
+  static ObjectPtr<CallableObject> plus(make_builtin(plus_function));
   scope->set_value("+", plus);
 
-  static ObjectPtr<CallableObject> minus(make_simple_callable(minus_function));
+  static ObjectPtr<CallableObject> minus(make_builtin(minus_function));
   scope->set_value("-", minus);
 
-  static ObjectPtr<CallableObject> mul(make_simple_callable(mul_function));
+  static ObjectPtr<CallableObject> mul(make_builtin(mul_function));
   scope->set_value("*", mul);
 
-  static ObjectPtr<CallableObject> div(make_simple_callable(div_function));
+  static ObjectPtr<CallableObject> div(make_builtin(div_function));
   scope->set_value("/", div);
 
   static ObjectPtr<CallableObject> less(
-      make_simple_callable(CompareFunc<NumberObject,
-                                       std::less<double>>("<")));
+      make_builtin(CompareFunc<NumberObject,
+                               std::less<double>>("<")));
   scope->set_value("<", less);
 
   static ObjectPtr<CallableObject> less_equal(
-      make_simple_callable(CompareFunc<NumberObject,
-                                       std::less_equal<double>>("<=")));
+      make_builtin(CompareFunc<NumberObject,
+                               std::less_equal<double>>("<=")));
   scope->set_value("<=", less_equal);
 
   static ObjectPtr<CallableObject> greater(
-      make_simple_callable(CompareFunc<NumberObject,
-                                       std::greater<double>>(">")));
+      make_builtin(CompareFunc<NumberObject,
+                               std::greater<double>>(">")));
   scope->set_value(">", greater);
 
   static ObjectPtr<CallableObject> greater_equal(
-      make_simple_callable(CompareFunc<NumberObject,
-                                       std::greater_equal<double>>(">=")));
+      make_builtin(CompareFunc<NumberObject,
+                               std::greater_equal<double>>(">=")));
   scope->set_value(">=", greater_equal);
 
   static ObjectPtr<CallableObject> equal(
-      make_simple_callable(CompareFunc<NumberObject,
-                                       std::equal_to<double>>("=")));
+      make_builtin(CompareFunc<NumberObject,
+                               std::equal_to<double>>("=")));
   scope->set_value("=", equal);
 
   // Characters operations
   static ObjectPtr<CallableObject> string_len(
-      make_simple_callable(string_len_function));
+      make_builtin(string_len_function));
   scope->set_value("string-length", string_len);
 
   static ObjectPtr<CallableObject> less_chars(
-      make_simple_callable(
+      make_builtin(
           CompareFunc<CharactersObject, std::less<std::string>>("string<?")));
   scope->set_value("string<?", less_chars);
 
   static ObjectPtr<CallableObject> less_equal_chars(
-      make_simple_callable(
+      make_builtin(
           CompareFunc<CharactersObject,
                       std::less_equal<std::string>>("string<=?")));
   scope->set_value("string<=?", less_equal_chars);
 
   static ObjectPtr<CallableObject> greater_chars(
-      make_simple_callable(
+      make_builtin(
           CompareFunc<CharactersObject,
                       std::greater<std::string>>("string>?")));
   scope->set_value("string>?", greater_chars);
 
   static ObjectPtr<CallableObject> greater_equal_chars(
-      make_simple_callable(
+      make_builtin(
           CompareFunc<CharactersObject,
                       std::greater_equal<std::string>>("string>=?")));
   scope->set_value("string>=?", greater_equal_chars);
 
   static ObjectPtr<CallableObject> equal_chars(
-      make_simple_callable(
+      make_builtin(
           CompareFunc<CharactersObject,
                       std::equal_to<std::string>>("string=?")));
   scope->set_value("string=?", equal_chars);
 
   // Misc
-  static ObjectPtr<CallableObject> print(make_simple_callable(print_function));
+  static ObjectPtr<CallableObject> print(make_builtin(print_function));
   scope->set_value("print", print);
 
-  static ObjectPtr<CallableObject> exit(make_simple_callable(exit_function));
+  static ObjectPtr<CallableObject> exit(make_builtin(exit_function));
   scope->set_value("exit", exit);
 
-  static ObjectPtr<CallableObject> throw_(make_simple_callable(throw_function));
+  static ObjectPtr<CallableObject> throw_(make_builtin(throw_function));
   scope->set_value("throw", throw_);
 
   scope->set_value("null", nullptr);
 }
 
-void init_scope_with_stdlibs(const std::shared_ptr<Scope>& scope) {
-  VirtualMachine<> vm(scope);
-  vm.eval_all(builtins::kBuiltinsStdlib_common);
+void init_scope_with_stdlibs(const ScopePtr& scope) {
+  static const std::vector<ObjectPtr<>> common_forms(
+      load_stdlib_image(builtins::kBuiltinsStdlib_common));
+  eval_forms(scope, common_forms);
+}
+
+void init_scope_with_reference_stdlibs(const ScopePtr& scope) {
+  static const std::vector<ObjectPtr<>> list_forms(
+      load_stdlib_image(builtins::kBuiltinsStdlib_list));
+  eval_forms(scope, list_forms);
 }
 
 } // lispp
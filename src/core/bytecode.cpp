@@ -0,0 +1,58 @@
+#include <lispp/bytecode.h>
+
+#include <map>
+
+namespace lispp {
+
+constexpr std::size_t GlobalCache::kEntriesCount;
+
+std::ostream& operator<<(std::ostream& out, OpCode opcode) {
+  static const std::map<OpCode, std::string> kOpCodeNames{
+    {OpCode::kLoadConst,       "LoadConst"},
+    {OpCode::kLoadNil,         "LoadNil"},
+    {OpCode::kLoadVar,         "LoadVar"},
+    {OpCode::kLoadGlobal,      "LoadGlobal"},
+    {OpCode::kLoadLocal,       "LoadLocal"},
+    {OpCode::kDefineVar,       "DefineVar"},
+    {OpCode::kSetVar,          "SetVar"},
+    {OpCode::kSetLocal,        "SetLocal"},
+    {OpCode::kPop,             "Pop"},
+    {OpCode::kJump,            "Jump"},
+    {OpCode::kJumpIfFalse,     "JumpIfFalse"},
+    {OpCode::kJumpIfFalseKeep, "JumpIfFalseKeep"},
+    {OpCode::kJumpIfTrueKeep,  "JumpIfTrueKeep"},
+    {OpCode::kMakeClosure,     "MakeClosure"},
+    {OpCode::kPrepareCall,     "PrepareCall"},
+    {OpCode::kCallMacro,       "CallMacro"},
+    {OpCode::kCall,            "Call"},
+    {OpCode::kTailCall,        "TailCall"},
+    {OpCode::kEnterScope,      "EnterScope"},
+    {OpCode::kLeaveScope,      "LeaveScope"},
+    {OpCode::kEvalForm,        "EvalForm"},
+    {OpCode::kReturn,          "Return"}
+  };
+
+  auto name_iter = kOpCodeNames.find(opcode);
+  if (name_iter != kOpCodeNames.end()) {
+    out << name_iter->second;
+  } else {
+    out << "<unknown>";
+  }
+
+  return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const Instruction& instruction) {
+  return (out << instruction.opcode << " " << instruction.arg << " "
+              << instruction.extra_arg);
+}
+
+std::ostream& operator<<(std::ostream& out, const CodeObject& code) {
+  for (std::size_t index = 0; index < code.instructions.size(); ++index) {
+    out << index << ": " << code.instructions[index] << std::endl;
+  }
+
+  return out;
+}
+
+} // lispp
@@ -13,33 +13,72 @@ std::string CallableObject::to_string() const {
   }
 }
 
-ObjectPtr<> CallableObject::execute(const std::shared_ptr<Scope>& scope,
+ObjectPtr<> CallableObject::execute(const ScopePtr& scope,
                                     const ObjectPtr<>& args) {
-  ObjectPtr<> prepared_args(prepare_args(args, scope));
+  ArgsBuffer prepared_args;
+  prepare_args(args, scope, &prepared_args);
 
-  std::shared_ptr<Scope> local_scope = scope;
+  return call(scope, prepared_args.get_span());
+}
+
+TailResult CallableObject::execute_tail(const ScopePtr& scope,
+                                        const ObjectPtr<>& args) {
+  ArgsBuffer prepared_args;
+  prepare_args(args, scope, &prepared_args);
+
+  return execute_tail_impl(get_local_scope(scope), prepared_args.get_span());
+}
+
+ObjectPtr<> CallableObject::call(const ScopePtr& scope, ArgsSpan args) {
+  return execute_impl(get_local_scope(scope), args);
+}
+
+ScopePtr CallableObject::get_local_scope(
+    const ScopePtr& scope) const {
   if (create_separate_scope_) {
-    local_scope = scope->create_child_scope();
+    return scope->create_child_scope();
+  } else {
+    return scope;
   }
+}
 
-  auto unpacked_args = unpack_list(prepared_args);
+void CallableObject::prepare_args(const ObjectPtr<>& src_args,
+                                  const ScopePtr& scope,
+                                  ArgsBuffer* args) const {
+  ObjectPtr<> tail = src_args;
+  while (tail.valid()) {
+    const ConsObject* cons_tail = tail->as_cons();
+    if (cons_tail == nullptr) {
+      throw ExecutionError("Unpack list: unexpected list tail");
+    }
 
-  return execute_impl(local_scope, unpacked_args);
+    if (type_ == CallableType::kFunction) {
+      args->push_back(cons_tail->get_left_value().safe_eval(scope));
+    } else {
+      args->push_back(cons_tail->get_left_value());
+    }
+    tail = cons_tail->get_right_value();
+  }
 }
 
-ObjectPtr<> CallableObject::prepare_args(
-    const ObjectPtr<>& src_args, const std::shared_ptr<Scope>& scope) const {
-
-  if (type_ == CallableType::kFunction) {
-    ObjectPtr<> sources(src_args);
-    return map_list(src_args, [&scope](ObjectPtr<> object) {
-        return object->eval(scope);
-    });
+TailResult eval_tail(const ObjectPtr<>& expression,
+                     const ScopePtr& scope) {
+  auto cons_expression = expression.safe_cast<ConsObject>();
+  if (cons_expression.valid()) {
+    return cons_expression->eval_tail(scope);
   } else {
-    return src_args;
+    return expression.safe_eval(scope);
   }
 }
 
+ObjectPtr<> run_trampoline(TailResult result) {
+  while (result.is_tail()) {
+    result = eval_tail(result.value, result.scope);
+  }
+
+  return result.value;
+}
+
 std::ostream& operator<<(std::ostream& out, const CallableObject& obj) {
   return (out << obj.to_string());
 }
@@ -0,0 +1,65 @@
+#include <lispp/compiled_callable_object.h>
+
+#include <sstream>
+
+#include <lispp/compiler.h>
+#include <lispp/cycle_collector.h>
+#include <lispp/interpreter.h>
+#include <lispp/list_utils.h>
+
+namespace lispp {
+
+CompiledCallableObject::CompiledCallableObject(
+    const std::shared_ptr<LambdaTemplate>& lambda,
+    const ScopePtr& closure)
+    : CallableObject(CallableType::kFunction), lambda_(lambda),
+    closure_(closure) {
+  CycleCollector::get_current().track(closure_.get());
+}
+
+void CompiledCallableObject::traverse(ReferenceVisitor& visitor) const {
+  visitor.visit(closure_);
+}
+
+void CompiledCallableObject::clear_references() {
+  closure_.reset();
+}
+
+const std::shared_ptr<CodeObject>& CompiledCallableObject::get_code() {
+  std::call_once(lambda_->compile_once, [this] {
+    lambda_->code = Compiler(closure_).compile_lambda(*lambda_);
+  });
+
+  return lambda_->code;
+}
+
+ScopePtr CompiledCallableObject::create_frame(ArgsSpan args) const {
+  const std::size_t args_count = args.size();
+  const std::size_t args_expected = lambda_->args_count;
+  if (args_count < args_expected ||
+      (!lambda_->has_rest_arg && args_count > args_expected)) {
+    std::stringstream ss;
+    ss << lambda_->name << " function expects " << args_expected
+       << " arguments but " << args_count << " given";
+    throw ExecutionError(ss.str());
+  }
+
+  auto frame = Scope::create_frame(closure_, lambda_->slot_names.get());
+  for (std::size_t arg_index = 0; arg_index < args_expected; ++arg_index) {
+    frame->set_slot(arg_index, args[arg_index]);
+  }
+
+  if (lambda_->has_rest_arg) {
+    frame->set_slot(args_expected, pack_list(args.subspan(args_expected)));
+  }
+
+  return frame;
+}
+
+ObjectPtr<> CompiledCallableObject::execute_impl(
+    const ScopePtr&, ArgsSpan args) {
+  Interpreter interpreter;
+  return interpreter.call(this, args);
+}
+
+} // lispp
@@ -0,0 +1,592 @@
+#include <lispp/compiler.h>
+
+#include <lispp/objects_all.h>
+#include <lispp/list_utils.h>
+#include <lispp/function_utils.h>
+
+namespace lispp {
+
+Compiler::Compiler(const ScopePtr& scope)
+    : scope_(scope) {}
+
+std::shared_ptr<CodeObject> Compiler::compile(const ObjectPtr<>& form) {
+  code_ = std::make_shared<CodeObject>();
+  name_indices_.clear();
+  frames_.clear();
+
+  compile_expression(form, true);
+
+  return code_;
+}
+
+std::shared_ptr<CodeObject> Compiler::compile_lambda(
+    const LambdaTemplate& lambda) {
+  code_ = std::make_shared<CodeObject>();
+  name_indices_.clear();
+  frames_ = lambda.enclosing_frames;
+  frames_.push_back(std::make_shared<FrameLayout>(lambda.slot_names));
+  frames_.back()->has_runtime_defines = may_define_at_run_time(lambda.body);
+
+  compile_body(lambda.body, true);
+
+  return code_;
+}
+
+void Compiler::compile_expression(const ObjectPtr<>& form, bool tail) {
+  if (!form.valid()) {
+    // NOTE: tree-walking eval throws a proper error
+    compile_fallback(form, tail);
+  } else if (form->as_symbol()) {
+    compile_variable(form->as_symbol()->get_id(), tail);
+  } else if (form->as_cons()) {
+    compile_cons(form->as_cons(), tail);
+  } else if (form->as_quote()) {
+    emit(OpCode::kLoadConst, add_constant(form->as_quote()->get_value()));
+    emit_return(tail);
+  } else if (form->as_number() || form->as_characters() ||
+             form->as_boolean() || form->as_callable()) {
+    emit(OpCode::kLoadConst, add_constant(form));
+    emit_return(tail);
+  } else {
+    compile_fallback(form, tail);
+  }
+}
+
+void Compiler::compile_variable(SymbolId name, bool tail) {
+  int depth = 0;
+  int slot = -1;
+  resolve_variable(name, &depth, &slot);
+
+  if (slot >= 0) {
+    emit(OpCode::kLoadLocal, slot, depth);
+  } else if (depth == static_cast<int>(frames_.size()) &&
+             has_runtime_defines()) {
+    emit(OpCode::kLoadVar, add_name(name), 0);
+  } else if (depth == static_cast<int>(frames_.size())) {
+    emit(OpCode::kLoadGlobal, add_name(name), depth);
+  } else {
+    emit(OpCode::kLoadVar, add_name(name), depth);
+  }
+  emit_return(tail);
+}
+
+void Compiler::compile_body(const std::vector<ObjectPtr<>>& body, bool tail) {
+  if (body.empty()) {
+    emit(OpCode::kLoadNil);
+    emit_return(tail);
+    return;
+  }
+
+  for (std::size_t expr_index = 0; expr_index + 1 < body.size(); ++expr_index) {
+    compile_expression(body[expr_index], false);
+    emit(OpCode::kPop);
+  }
+  compile_expression(body.back(), tail);
+}
+
+void Compiler::compile_cons(const ObjectPtr<ConsObject>& form, bool tail) {
+  if (!form->get_left_value().valid()) {
+    compile_fallback(form, tail);
+    return;
+  }
+
+  auto macro = resolve_macro(form->get_left_value());
+  if (!macro.valid()) {
+    compile_call(form, tail);
+  } else if (macro->get_special_form() == SpecialForm::kNone ||
+             !compile_special_form(macro->get_special_form(), form, tail)) {
+    compile_macro_call(form, tail);
+  }
+}
+
+void Compiler::compile_call(const ObjectPtr<ConsObject>& form, bool tail) {
+  std::vector<ObjectPtr<>> args;
+  auto rest = unpack_list_rest(form->get_right_value(), &args);
+  if (rest.valid()) {
+    compile_fallback(form, tail);
+    return;
+  }
+
+  compile_expression(form->get_left_value(), false);
+  const int prepare_index = emit(OpCode::kPrepareCall, add_constant(form));
+  for (const auto& arg : args) {
+    compile_expression(arg, false);
+  }
+
+  const int args_count = static_cast<int>(args.size());
+  emit(tail ? OpCode::kTailCall : OpCode::kCall, args_count);
+
+  // NOTE: macro expanded by kPrepareCall continues from here
+  code_->instructions[prepare_index].extra_arg = current_position();
+  emit_return(tail);
+}
+
+void Compiler::compile_macro_call(const ObjectPtr<ConsObject>& form,
+                                  bool tail) {
+  compile_expression(form->get_left_value(), false);
+  emit(OpCode::kCallMacro, add_constant(form));
+  emit_return(tail);
+}
+
+void Compiler::compile_fallback(const ObjectPtr<>& form, bool tail) {
+  emit(OpCode::kEvalForm, add_constant(form));
+  emit_return(tail);
+}
+
+void Compiler::compile_condition(const ObjectPtr<>& condition) {
+  // NOTE: nil condition is true (see is_true_condition)
+  if (condition.valid()) {
+    compile_expression(condition, false);
+  } else {
+    emit(OpCode::kLoadNil);
+  }
+}
+
+bool Compiler::compile_special_form(SpecialForm special_form,
+                                    const ObjectPtr<ConsObject>& form,
+                                    bool tail) {
+  std::vector<ObjectPtr<>> args;
+  auto rest = unpack_list_rest(form->get_right_value(), &args);
+  if (rest.valid()) {
+    return false;
+  }
+
+  switch (special_form) {
+    case SpecialForm::kQuote:
+      return compile_quote(args, tail);
+    case SpecialForm::kIf:
+      return compile_if(args, tail);
+    case SpecialForm::kCond:
+      return compile_cond(args, tail);
+    case SpecialForm::kDefine:
+      return compile_define(args, tail);
+    case SpecialForm::kSet:
+      return compile_set(args, tail);
+    case SpecialForm::kLambda:
+      return compile_lambda_form(args, tail);
+    case SpecialForm::kLet:
+      return compile_let(args, tail);
+    case SpecialForm::kAnd:
+      return compile_and_or(args, true, tail);
+    case SpecialForm::kOr:
+      return compile_and_or(args, false, tail);
+    default:
+      return false;
+  }
+}
+
+bool Compiler::compile_quote(const std::vector<ObjectPtr<>>& args, bool tail) {
+  if (args.size() != 1) {
+    return false;
+  }
+
+  emit(OpCode::kLoadConst, add_constant(args[0]));
+  emit_return(tail);
+  return true;
+}
+
+bool Compiler::compile_if(const std::vector<ObjectPtr<>>& args, bool tail) {
+  if (args.size() < 2 || args.size() > 3) {
+    return false;
+  }
+
+  compile_condition(args[0]);
+  const int else_jump = emit(OpCode::kJumpIfFalse);
+  compile_expression(args[1], tail);
+
+  int end_jump = -1;
+  if (!tail) {
+    end_jump = emit(OpCode::kJump);
+  }
+
+  patch_jump(else_jump, current_position());
+  if (args.size() == 3) {
+    compile_expression(args[2], tail);
+  } else {
+    emit(OpCode::kLoadNil);
+    emit_return(tail);
+  }
+
+  if (!tail) {
+    patch_jump(end_jump, current_position());
+  }
+  return true;
+}
+
+bool Compiler::compile_cond(const std::vector<ObjectPtr<>>& args, bool tail) {
+  std::vector<std::vector<ObjectPtr<>>> branches(args.size());
+  for (std::size_t branch_index = 0; branch_index < args.size();
+       ++branch_index) {
+    auto& branch = branches[branch_index];
+    if (!args[branch_index].safe_cast<ConsObject>().valid() ||
+        unpack_list_rest(args[branch_index], &branch).valid() ||
+        branch.size() < 2 || !branch[1].valid()) {
+      return false;
+    }
+  }
+
+  std::vector<int> end_jumps;
+  for (const auto& branch : branches) {
+    compile_condition(branch[0]);
+    const int next_jump = emit(OpCode::kJumpIfFalse);
+    compile_expression(branch[1], tail);
+    if (!tail) {
+      end_jumps.push_back(emit(OpCode::kJump));
+    }
+    patch_jump(next_jump, current_position());
+  }
+
+  emit(OpCode::kLoadNil);
+  emit_return(tail);
+
+  for (int end_jump : end_jumps) {
+    patch_jump(end_jump, current_position());
+  }
+  return true;
+}
+
+bool Compiler::compile_define(const std::vector<ObjectPtr<>>& args,
+                              bool tail) {
+  if (args.size() < 2) {
+    return false;
+  }
+
+  SymbolId name = 0;
+  auto varname_symbol = args[0].safe_cast<SymbolObject>();
+  if (varname_symbol.valid()) {
+    if (args.size() != 2) {
+      return false;
+    }
+
+    name = varname_symbol->get_id();
+    compile_expression(args[1], false);
+  } else {
+    auto header = args[0].safe_cast<ConsObject>();
+    if (!header.valid()) {
+      return false;
+    }
+
+    auto function_name = header->get_left_value().safe_cast<SymbolObject>();
+    if (!function_name.valid()) {
+      return false;
+    }
+
+    name = function_name->get_id();
+    auto lambda = make_lambda_template(function_name->get_value(),
+                                       header->get_right_value(),
+                                       std::next(args.begin()), args.end());
+    if (!lambda) {
+      return false;
+    }
+
+    emit(OpCode::kMakeClosure, add_lambda(lambda));
+  }
+
+  emit(OpCode::kDefineVar, add_name(name));
+  add_defined_name(name);
+
+  emit(OpCode::kLoadNil);
+  emit_return(tail);
+  return true;
+}
+
+bool Compiler::compile_set(const std::vector<ObjectPtr<>>& args, bool tail) {
+  if (args.size() != 2) {
+    return false;
+  }
+
+  auto symbol = args[0].safe_cast<SymbolObject>();
+  if (!symbol.valid()) {
+    return false;
+  }
+
+  compile_expression(args[1], false);
+
+  int depth = 0;
+  int slot = -1;
+  resolve_variable(symbol->get_id(), &depth, &slot);
+  if (depth == static_cast<int>(frames_.size()) && has_runtime_defines()) {
+    depth = 0;
+  }
+  if (slot >= 0) {
+    emit(OpCode::kSetLocal, slot, depth);
+  } else {
+    emit(OpCode::kSetVar, add_name(symbol->get_id()), depth);
+  }
+
+  emit(OpCode::kLoadNil);
+  emit_return(tail);
+  return true;
+}
+
+bool Compiler::compile_lambda_form(const std::vector<ObjectPtr<>>& args,
+                                   bool tail) {
+  if (args.size() < 2) {
+    return false;
+  }
+
+  auto lambda = make_lambda_template(make_lambda_name(), args[0],
+                                     std::next(args.begin()), args.end());
+  if (!lambda) {
+    return false;
+  }
+
+  emit(OpCode::kMakeClosure, add_lambda(lambda));
+  emit_return(tail);
+  return true;
+}
+
+bool Compiler::compile_let(const std::vector<ObjectPtr<>>& args, bool tail) {
+  if (args.empty()) {
+    return false;
+  }
+
+  std::vector<ObjectPtr<>> varlist;
+  if (unpack_list_rest(args[0], &varlist).valid()) {
+    return false;
+  }
+
+  SlotNames var_names;
+  std::vector<ObjectPtr<>> var_values;
+  for (const auto& var_item : varlist) {
+    std::vector<ObjectPtr<>> var_info;
+    if (unpack_list_rest(var_item, &var_info).valid() ||
+        var_info.size() != 2 || !var_info[0].safe_cast<SymbolObject>()) {
+      return false;
+    }
+
+    var_names.push_back(var_info[0]->as_symbol()->get_id());
+    var_values.push_back(var_info[1]);
+  }
+
+  for (const auto& value : var_values) {
+    compile_expression(value, false);
+  }
+
+  auto layout = intern_slot_names(var_names);
+  emit(OpCode::kEnterScope, add_layout(layout));
+
+  const std::vector<ObjectPtr<>> body(std::next(args.begin()), args.end());
+  frames_.push_back(std::make_shared<FrameLayout>(layout));
+  frames_.back()->has_runtime_defines = may_define_at_run_time(body);
+  compile_body(body, tail);
+  frames_.pop_back();
+
+  // NOTE: in tail position the frame is left with the let scope
+  if (!tail) {
+    emit(OpCode::kLeaveScope);
+  }
+  return true;
+}
+
+bool Compiler::compile_and_or(const std::vector<ObjectPtr<>>& args,
+                              bool is_and, bool tail) {
+  if (args.empty()) {
+    emit(OpCode::kLoadConst, add_constant(BooleanObject::make(is_and)));
+    emit_return(tail);
+    return true;
+  }
+
+  const OpCode jump_opcode = (is_and ? OpCode::kJumpIfFalseKeep
+                                     : OpCode::kJumpIfTrueKeep);
+  std::vector<int> end_jumps;
+  for (std::size_t arg_index = 0; arg_index + 1 < args.size(); ++arg_index) {
+    compile_expression(args[arg_index], false);
+    end_jumps.push_back(emit(jump_opcode));
+  }
+  compile_expression(args.back(), tail);
+
+  const int end_position = (tail ? emit(OpCode::kReturn) : current_position());
+  for (int end_jump : end_jumps) {
+    patch_jump(end_jump, end_position);
+  }
+  return true;
+}
+
+std::shared_ptr<LambdaTemplate> Compiler::make_lambda_template(
+    const std::string& name, const ObjectPtr<>& arg_list,
+    std::vector<ObjectPtr<>>::const_iterator body_begin,
+    std::vector<ObjectPtr<>>::const_iterator body_end) {
+  auto lambda = std::make_shared<LambdaTemplate>();
+  lambda->name = name;
+
+  SlotNames slot_names;
+  std::vector<ObjectPtr<>> arg_symbols;
+  auto rest_arg = unpack_list_rest(arg_list, &arg_symbols);
+  for (const auto& arg_symbol : arg_symbols) {
+    auto symbol = arg_symbol.safe_cast<SymbolObject>();
+    if (!symbol.valid()) {
+      return nullptr;
+    }
+    slot_names.push_back(symbol->get_id());
+  }
+  lambda->args_count = slot_names.size();
+
+  if (rest_arg.valid()) {
+    auto rest_symbol = rest_arg.safe_cast<SymbolObject>();
+    if (!rest_symbol.valid()) {
+      return nullptr;
+    }
+    slot_names.push_back(rest_symbol->get_id());
+    lambda->has_rest_arg = true;
+  }
+
+  lambda->slot_names = intern_slot_names(slot_names);
+  lambda->enclosing_frames = frames_;
+
+  lambda->body.assign(body_begin, body_end);
+  return lambda;
+}
+
+ObjectPtr<CallableObject> Compiler::resolve_macro(
+    const ObjectPtr<>& op) const {
+  auto symbol = op.safe_cast<SymbolObject>();
+  if (!symbol.valid() || is_local(symbol->get_id()) ||
+      !scope_->has_value(symbol->get_id())) {
+    return nullptr;
+  }
+
+  auto callable = scope_->get_value(symbol->get_id())
+      .safe_cast<CallableObject>();
+  if (!callable.valid() || callable->get_type() != CallableType::kMacro) {
+    return nullptr;
+  }
+
+  return callable;
+}
+
+void Compiler::resolve_variable(SymbolId name, int* depth,
+                                int* slot) const {
+  *slot = -1;
+  for (std::size_t frame_index = frames_.size(); frame_index > 0;
+       --frame_index) {
+    const FrameLayout& frame = *frames_[frame_index - 1];
+    *depth = static_cast<int>(frames_.size() - frame_index);
+    if (frame.defined_names.count(name) > 0) {
+      return;
+    }
+
+    // NOTE: the last one wins for duplicated names (see Scope::find_slot)
+    const SlotNames& slot_names = *frame.slot_names;
+    for (std::size_t slot_index = slot_names.size(); slot_index > 0;
+         --slot_index) {
+      if (slot_names[slot_index - 1] == name) {
+        *slot = static_cast<int>(slot_index - 1);
+        return;
+      }
+    }
+  }
+
+  *depth = static_cast<int>(frames_.size());
+}
+
+bool Compiler::is_local(SymbolId name) const {
+  int depth = 0;
+  int slot = -1;
+  resolve_variable(name, &depth, &slot);
+  return depth < static_cast<int>(frames_.size());
+}
+
+// NOTE: Conservative: calls of macroses other than the compiled special
+//       forms (eval among them) and the forms left for the tree-walking
+//       eval may define names. Nested lambdas are scanned too
+bool Compiler::may_define_at_run_time(const ObjectPtr<>& form) const {
+  if (!form.valid() || form->as_symbol() || form->as_quote() ||
+      form->as_number() || form->as_characters() || form->as_boolean() ||
+      form->as_callable()) {
+    return false;
+  }
+
+  auto cons = form->as_cons();
+  if (cons == nullptr || !cons->get_left_value().valid()) {
+    return true;
+  }
+
+  auto macro = resolve_macro(cons->get_left_value());
+  if (macro.valid() && macro->get_special_form() == SpecialForm::kNone) {
+    return true;
+  } else if (macro.valid() &&
+             macro->get_special_form() == SpecialForm::kQuote) {
+    return false;
+  }
+
+  std::vector<ObjectPtr<>> items;
+  if (unpack_list_rest(form, &items).valid()) {
+    return true;
+  }
+  return may_define_at_run_time(items);
+}
+
+bool Compiler::may_define_at_run_time(
+    const std::vector<ObjectPtr<>>& body) const {
+  for (const auto& form : body) {
+    if (may_define_at_run_time(form)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Compiler::has_runtime_defines() const {
+  for (const auto& frame : frames_) {
+    if (frame->has_runtime_defines) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Compiler::add_defined_name(SymbolId name) {
+  if (!frames_.empty()) {
+    frames_.back()->defined_names.insert(name);
+  }
+}
+
+int Compiler::emit(OpCode opcode, int arg, int extra_arg) {
+  code_->instructions.emplace_back(opcode, arg, extra_arg);
+  return current_position() - 1;
+}
+
+void Compiler::emit_return(bool tail) {
+  if (tail) {
+    emit(OpCode::kReturn);
+  }
+}
+
+int Compiler::current_position() const {
+  return static_cast<int>(code_->instructions.size());
+}
+
+void Compiler::patch_jump(int instruction_index, int target) {
+  code_->instructions[instruction_index].arg = target;
+}
+
+int Compiler::add_constant(const ObjectPtr<>& constant) {
+  code_->constants.push_back(constant);
+  return static_cast<int>(code_->constants.size()) - 1;
+}
+
+int Compiler::add_name(SymbolId name) {
+  auto name_it = name_indices_.find(name);
+  if (name_it != name_indices_.end()) {
+    return name_it->second;
+  }
+
+  code_->names.push_back(name);
+  code_->global_caches.emplace_back();
+  const int index = static_cast<int>(code_->names.size()) - 1;
+  name_indices_[name] = index;
+  return index;
+}
+
+int Compiler::add_lambda(const std::shared_ptr<LambdaTemplate>& lambda) {
+  code_->lambdas.push_back(lambda);
+  return static_cast<int>(code_->lambdas.size()) - 1;
+}
+
+int Compiler::add_layout(const std::shared_ptr<const SlotNames>& layout) {
+  code_->layouts.push_back(layout);
+  return static_cast<int>(code_->layouts.size()) - 1;
+}
+
+} // lispp
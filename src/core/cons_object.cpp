@@ -2,6 +2,7 @@
 
 #include <lispp/scope.h>
 #include <lispp/callable_object.h>
+#include <lispp/cycle_collector.h>
 
 namespace lispp {
 
@@ -23,7 +24,21 @@ std::string ConsObject::to_string() const {
   }
 }
 
-ObjectPtr<> ConsObject::eval(const std::shared_ptr<Scope>& scope) {
+void ConsObject::traverse(ReferenceVisitor& visitor) const {
+  visitor.visit(left_value_);
+  visitor.visit(right_value_);
+}
+
+void ConsObject::clear_references() {
+  left_value_.reset();
+  right_value_.reset();
+}
+
+ObjectPtr<> ConsObject::eval(const ScopePtr& scope) {
+  return run_trampoline(eval_tail(scope));
+}
+
+TailResult ConsObject::eval_tail(const ScopePtr& scope) {
   if (!left_value_.valid()) {
     throw ExecutionError("Cannot execute empty list");
   }
@@ -38,7 +53,7 @@ ObjectPtr<> ConsObject::eval(const std::shared_ptr<Scope>& scope) {
     throw ExecutionError(evaled_value->to_string() + " is not callable");
   }
 
-  return callable->execute(scope, right_value_);
+  return callable->execute_tail(scope, right_value_);
 }
 
 void ConsObject::print_as_tail(std::ostream& out) const {
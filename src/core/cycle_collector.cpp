@@ -0,0 +1,231 @@
+#include <lispp/cycle_collector.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include <lispp/scope.h>
+
+namespace lispp {
+
+constexpr std::size_t CycleCollector::kDefaultThreshold;
+
+namespace {
+
+  thread_local bool collector_destroyed = false;
+
+  struct Node {
+    Object* object = nullptr;
+    Scope* scope = nullptr;
+    long ref_count = 0;
+    long internal_refs = 0;
+    std::size_t edges_begin = 0;
+    std::size_t edges_end = 0;
+    bool reachable = false;
+  };
+
+  // NOTE: Builds the graph of everything reachable from the tracked scopes.
+  //       Every edge between the nodes is counted as an internal reference
+  class GraphBuilder : public ReferenceVisitor {
+  public:
+    void add_root(Scope* scope) {
+      add_node(nullptr, scope, scope->get_ref_count());
+    }
+
+    void build() {
+      for (std::size_t node_index = 0; node_index < nodes_.size();
+           ++node_index) {
+        nodes_[node_index].edges_begin = edges_.size();
+        if (nodes_[node_index].object != nullptr) {
+          nodes_[node_index].object->traverse(*this);
+        } else {
+          nodes_[node_index].scope->traverse(*this);
+        }
+        nodes_[node_index].edges_end = edges_.size();
+      }
+    }
+
+    void visit(const ObjectPtr<>& object) override {
+      if (object.valid() && !object->is_immortal()) {
+        add_edge(add_node(object.get(), nullptr, object->get_ref_count()));
+      }
+    }
+
+    void visit(const ScopePtr& scope) override {
+      if (scope && !scope->is_frozen()) {
+        add_edge(add_node(nullptr, scope.get(), scope->get_ref_count()));
+      }
+    }
+
+    std::vector<Node>& get_nodes() { return nodes_; }
+    const std::vector<std::size_t>& get_edges() const { return edges_; }
+
+  private:
+    std::size_t add_node(Object* object, Scope* scope, long ref_count) {
+      const void* key = (object != nullptr ? static_cast<const void*>(object)
+                                           : static_cast<const void*>(scope));
+      auto index_it = indices_.find(key);
+      if (index_it != indices_.end()) {
+        return index_it->second;
+      }
+
+      Node node;
+      node.object = object;
+      node.scope = scope;
+      node.ref_count = ref_count;
+      nodes_.push_back(node);
+      indices_.emplace(key, nodes_.size() - 1);
+      return nodes_.size() - 1;
+    }
+
+    void add_edge(std::size_t target) {
+      ++nodes_[target].internal_refs;
+      edges_.push_back(target);
+    }
+
+    std::unordered_map<const void*, std::size_t> indices_;
+    std::vector<Node> nodes_;
+    std::vector<std::size_t> edges_;
+  };
+
+  void mark_reachable(std::vector<Node>& nodes,
+                      const std::vector<std::size_t>& edges) {
+    std::vector<std::size_t> pending;
+    for (std::size_t node_index = 0; node_index < nodes.size(); ++node_index) {
+      if (nodes[node_index].ref_count > nodes[node_index].internal_refs) {
+        nodes[node_index].reachable = true;
+        pending.push_back(node_index);
+      }
+    }
+
+    while (!pending.empty()) {
+      const Node& node = nodes[pending.back()];
+      pending.pop_back();
+      for (std::size_t edge = node.edges_begin; edge < node.edges_end; ++edge) {
+        Node& target = nodes[edges[edge]];
+        if (!target.reachable) {
+          target.reachable = true;
+          pending.push_back(edges[edge]);
+        }
+      }
+    }
+  }
+
+} // namespace
+
+CycleCollector::CycleCollector() {
+  tracked_.prev = &tracked_;
+  tracked_.next = &tracked_;
+}
+
+// NOTE: scopes which outlive the thread are detached, so they don't
+//       untrack themselves later
+CycleCollector::~CycleCollector() {
+  CycleCollectorLink* link = tracked_.next;
+  while (link != &tracked_) {
+    CycleCollectorLink* next = link->next;
+    link->prev = nullptr;
+    link->next = nullptr;
+    link = next;
+  }
+  collector_destroyed = true;
+}
+
+bool CycleCollector::is_destroyed() {
+  return collector_destroyed;
+}
+
+CycleCollector& CycleCollector::get_current() {
+  static thread_local CycleCollector collector;
+  return collector;
+}
+
+void CycleCollector::track(Scope* scope) {
+  CycleCollectorLink& link = scope->collector_link_;
+  if (link.prev != nullptr || scope->is_frozen()) {
+    return;
+  }
+
+  link.scope = scope;
+  link.prev = &tracked_;
+  link.next = tracked_.next;
+  tracked_.next->prev = &link;
+  tracked_.next = &link;
+
+  ++tracked_count_;
+  ++tracked_since_collection_;
+}
+
+void CycleCollector::untrack(Scope* scope) {
+  CycleCollectorLink& link = scope->collector_link_;
+  if (link.prev == nullptr) {
+    return;
+  }
+
+  link.prev->next = link.next;
+  link.next->prev = link.prev;
+  link.prev = nullptr;
+  link.next = nullptr;
+
+  if (tracked_count_ > 0) {
+    --tracked_count_;
+  }
+}
+
+bool CycleCollector::maybe_collect() {
+  if (threshold_ == 0 || tracked_since_collection_ <= threshold_) {
+    return false;
+  }
+
+  collect();
+  return true;
+}
+
+CycleCollectorStats CycleCollector::collect() {
+  tracked_since_collection_ = 0;
+
+  GraphBuilder builder;
+  for (CycleCollectorLink* link = tracked_.next; link != &tracked_;
+       link = link->next) {
+    builder.add_root(link->scope);
+  }
+  builder.build();
+
+  auto& nodes = builder.get_nodes();
+  mark_reachable(nodes, builder.get_edges());
+
+  // NOTE: garbage is held until all of its references are cleared,
+  //       so nothing is freed while it's being cleared
+  std::vector<ObjectPtr<>> garbage_objects;
+  std::vector<ScopePtr> garbage_scopes;
+  for (const auto& node : nodes) {
+    if (node.reachable) {
+      continue;
+    }
+
+    if (node.object != nullptr) {
+      garbage_objects.emplace_back(node.object);
+    } else {
+      garbage_scopes.emplace_back(node.scope);
+    }
+  }
+
+  for (auto& object : garbage_objects) {
+    object->clear_references();
+  }
+  for (auto& scope : garbage_scopes) {
+    scope->clear();
+  }
+
+  CycleCollectorStats result;
+  result.collections = 1;
+  result.objects_freed = garbage_objects.size();
+  result.scopes_freed = garbage_scopes.size();
+
+  ++stats_.collections;
+  stats_.objects_freed += result.objects_freed;
+  stats_.scopes_freed += result.scopes_freed;
+
+  return result;
+}
+
+} // lispp
@@ -0,0 +1,68 @@
+#include <lispp/file_tokenizer.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lispp {
+
+namespace {
+
+  // NOTE: closes the descriptor, the mapping stays valid without it
+  class FileDescriptor {
+  public:
+    explicit FileDescriptor(int descriptor) : descriptor_(descriptor) {}
+    ~FileDescriptor() {
+      if (descriptor_ >= 0) {
+        close(descriptor_);
+      }
+    }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int get() const { return descriptor_; }
+
+  private:
+    int descriptor_;
+  };
+
+} // namespace
+
+FileTokenizer::FileTokenizer(const std::string& filename) {
+  FileDescriptor file(open(filename.c_str(), O_RDONLY));
+  struct stat file_stat;
+  if (file.get() < 0 || fstat(file.get(), &file_stat) != 0) {
+    throw TokenizerError("Cannot open file " + filename);
+  }
+
+  if (S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+    const std::size_t size = file_stat.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.get(), 0);
+    if (mapping != MAP_FAILED) {
+      posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+      mapping_ = mapping;
+      mapping_size_ = size;
+      set_buffer(static_cast<const char*>(mapping_), mapping_size_);
+      return;
+    }
+  }
+
+  char chunk[64 * 1024];
+  ssize_t read_count;
+  while ((read_count = read(file.get(), chunk, sizeof(chunk))) > 0) {
+    buffer_.append(chunk, read_count);
+  }
+  if (read_count < 0) {
+    throw TokenizerError("Cannot read file " + filename);
+  }
+  set_buffer(buffer_.data(), buffer_.size());
+}
+
+FileTokenizer::~FileTokenizer() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+} // lispp
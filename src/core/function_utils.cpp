@@ -1,20 +1,13 @@
 #include <lispp/function_utils.h>
 
+#include <atomic>
+
 #include <lispp/objects_all.h>
 
 namespace lispp {
 
-bool is_true_value(const ObjectPtr<>& object) {
-  ObjectPtr<BooleanObject> bool_object;
-  if (object != nullptr) {
-    bool_object = object->as_boolean();
-  }
-
-  return (bool_object == nullptr) || bool_object->get_value();
-}
-
 bool is_true_condition(const ObjectPtr<>& condition,
-                       const std::shared_ptr<Scope>& scope) {
+                       const ScopePtr& scope) {
   ObjectPtr<> eval_result;
   if (condition != nullptr) {
     eval_result = condition->eval(scope);
@@ -24,10 +17,18 @@ bool is_true_condition(const ObjectPtr<>& condition,
 }
 
 ObjectPtr<> safe_eval(const ObjectPtr<>& object,
-                      const std::shared_ptr<Scope>& scope) {
+                      const ScopePtr& scope) {
   return (object != nullptr ? object->eval(scope) : nullptr);
 }
 
+std::string make_lambda_name() {
+  // NOTE: shared by all isolates
+  static std::atomic<unsigned> lambda_number(0);
+  std::stringstream name_ss;
+  name_ss << "<lambda#" << lambda_number++ << ">";
+  return name_ss.str();
+}
+
 void check_args_count(const std::string& function_name,
                       std::size_t args_count,
                       std::size_t expected_args_count,
@@ -0,0 +1,283 @@
+#include <lispp/interpreter.h>
+
+#include <lispp/objects_all.h>
+#include <lispp/function_utils.h>
+
+namespace lispp {
+
+namespace {
+
+  CallableObject* get_callable(const ObjectPtr<>& object,
+                               const ObjectPtr<>& form) {
+    if (!object.valid()) {
+      const auto op = form->as_cons()->get_left_value();
+      throw ExecutionError(op->to_string() + " is not callable");
+    }
+
+    auto* callable = object->as_callable();
+    if (callable == nullptr) {
+      throw ExecutionError(object->to_string() + " is not callable");
+    }
+
+    return callable;
+  }
+
+} // namespace
+
+ObjectPtr<> Interpreter::run(const std::shared_ptr<CodeObject>& code,
+                             const ScopePtr& scope) {
+  frames_.push_back(Frame{code, 0, scope, stack_.size()});
+  return execute();
+}
+
+ObjectPtr<> Interpreter::call(const ObjectPtr<CompiledCallableObject>& callable,
+                              ArgsSpan args) {
+  auto scope = callable->create_frame(args);
+  frames_.push_back(Frame{callable->get_code(), 0, scope, stack_.size()});
+  return execute();
+}
+
+ObjectPtr<> Interpreter::execute() {
+  const std::size_t entry_depth = frames_.size() - 1;
+  const std::size_t entry_stack_size = frames_.back().stack_base;
+
+  try {
+    while (true) {
+      Frame& frame = frames_.back();
+      const CodeObject& code = *frame.code;
+      const Instruction& instruction = code.instructions[frame.pc++];
+
+      switch (instruction.opcode) {
+        case OpCode::kLoadConst:
+          stack_.push_back(code.constants[instruction.arg]);
+          break;
+
+        case OpCode::kLoadNil:
+          stack_.emplace_back();
+          break;
+
+        case OpCode::kLoadVar:
+          stack_.push_back(frame.scope->get_ancestor(instruction.extra_arg)
+                           ->get_value(code.names[instruction.arg]));
+          break;
+
+        case OpCode::kLoadGlobal:
+          stack_.push_back(load_global(
+              frame.code->global_caches[instruction.arg],
+              frame.scope->get_ancestor(instruction.extra_arg),
+              code.names[instruction.arg]));
+          break;
+
+        case OpCode::kLoadLocal:
+          stack_.push_back(frame.scope->get_ancestor(instruction.extra_arg)
+                           ->get_slot(instruction.arg));
+          break;
+
+        case OpCode::kDefineVar:
+          frame.scope->set_value(code.names[instruction.arg], stack_.back());
+          stack_.pop_back();
+          break;
+
+        case OpCode::kSetVar:
+          frame.scope->get_ancestor(instruction.extra_arg)->replace_value(
+              code.names[instruction.arg], stack_.back());
+          stack_.pop_back();
+          break;
+
+        case OpCode::kSetLocal:
+          frame.scope->get_ancestor(instruction.extra_arg)->set_slot(
+              instruction.arg, std::move(stack_.back()));
+          stack_.pop_back();
+          break;
+
+        case OpCode::kPop:
+          stack_.pop_back();
+          break;
+
+        case OpCode::kJump:
+          frame.pc = instruction.arg;
+          break;
+
+        case OpCode::kJumpIfFalse: {
+          const bool condition = is_true_value(stack_.back());
+          stack_.pop_back();
+          if (!condition) {
+            frame.pc = instruction.arg;
+          }
+          break;
+        }
+
+        case OpCode::kJumpIfFalseKeep:
+          if (!is_true_value(stack_.back())) {
+            frame.pc = instruction.arg;
+          } else {
+            stack_.pop_back();
+          }
+          break;
+
+        case OpCode::kJumpIfTrueKeep:
+          if (is_true_value(stack_.back())) {
+            frame.pc = instruction.arg;
+          } else {
+            stack_.pop_back();
+          }
+          break;
+
+        case OpCode::kMakeClosure:
+          stack_.push_back(new CompiledCallableObject(
+              code.lambdas[instruction.arg], frame.scope));
+          break;
+
+        case OpCode::kPrepareCall:
+          prepare_call(frame, instruction);
+          break;
+
+        case OpCode::kCallMacro:
+          call_macro(frame, instruction);
+          break;
+
+        case OpCode::kCall:
+          call_callable(frame, instruction.arg, false);
+          break;
+
+        case OpCode::kTailCall:
+          // NOTE: builtins leave the result on the stack and
+          //       the following kReturn leaves the frame
+          call_callable(frame, instruction.arg, true);
+          break;
+
+        case OpCode::kEnterScope: {
+          const auto& layout = code.layouts[instruction.arg];
+          auto scope = Scope::create_frame(frame.scope, layout.get());
+
+          const std::size_t values_base = stack_.size() - layout->size();
+          for (std::size_t slot = 0; slot < layout->size(); ++slot) {
+            scope->set_slot(slot, std::move(stack_[values_base + slot]));
+          }
+          stack_.resize(values_base);
+
+          frame.scope = std::move(scope);
+          break;
+        }
+
+        case OpCode::kLeaveScope:
+          frame.scope = frame.scope->get_parent_scope();
+          break;
+
+        case OpCode::kEvalForm:
+          stack_.push_back(code.constants[instruction.arg]
+                           .safe_eval(frame.scope));
+          break;
+
+        case OpCode::kReturn: {
+          ObjectPtr<> result = std::move(stack_.back());
+          stack_.resize(frame.stack_base);
+          frames_.pop_back();
+
+          if (frames_.size() == entry_depth) {
+            return result;
+          }
+          stack_.push_back(std::move(result));
+          break;
+        }
+      }
+    }
+  } catch (...) {
+    frames_.resize(entry_depth);
+    stack_.resize(entry_stack_size);
+    throw;
+  }
+}
+
+ObjectPtr<> Interpreter::load_global(GlobalCache& cache, Scope* scope,
+                                     SymbolId name) {
+  // NOTE: code of the frozen scope is shared by isolates, so its caches
+  //       are not filled (values of frozen scopes never change anyway)
+  if (scope->is_frozen()) {
+    return scope->get_value(name);
+  }
+
+  const std::uint64_t version = scope->get_version();
+  for (const auto& entry : cache.entries) {
+    if (entry.scope == scope && entry.version == version) {
+      return entry.value;
+    }
+  }
+
+  Object* value = nullptr;
+  if (!scope->get_versioned_value(name, &value)) {
+    return scope->get_value(name);
+  }
+
+  // NOTE: stale entries of the scope are replaced first
+  GlobalCache::Entry* target = nullptr;
+  for (auto& entry : cache.entries) {
+    if (entry.scope == scope) {
+      target = &entry;
+      break;
+    }
+  }
+  if (target == nullptr) {
+    target = &cache.entries[cache.next_entry];
+    cache.next_entry = (cache.next_entry + 1) % GlobalCache::kEntriesCount;
+  }
+
+  target->scope = scope;
+  target->version = version;
+  target->value = value;
+  return value;
+}
+
+void Interpreter::prepare_call(Frame& frame, const Instruction& instruction) {
+  const auto& form = frame.code->constants[instruction.arg];
+  ObjectPtr<CallableObject> callable(get_callable(stack_.back(), form));
+
+  if (callable->get_type() == CallableType::kMacro) {
+    stack_.pop_back();
+    stack_.push_back(callable->execute(
+        frame.scope, form->as_cons()->get_right_value()));
+    frame.pc = instruction.extra_arg;
+  }
+}
+
+void Interpreter::call_macro(Frame& frame, const Instruction& instruction) {
+  const auto& form = frame.code->constants[instruction.arg];
+  ObjectPtr<CallableObject> callable(get_callable(stack_.back(), form));
+
+  stack_.pop_back();
+  stack_.push_back(callable->execute(
+      frame.scope, form->as_cons()->get_right_value()));
+}
+
+void Interpreter::call_callable(Frame& frame, std::size_t args_count,
+                                bool tail) {
+  const std::size_t callee_index = stack_.size() - args_count - 1;
+  ObjectPtr<CallableObject> callable(stack_[callee_index]->as_callable());
+
+  ObjectPtr<CompiledCallableObject> compiled(
+      callable->as_compiled_callable());
+  if (!compiled.valid()) {
+    // NOTE: args are passed in place: the callee can't reenter this
+    //       interpreter (compiled closures run their own one)
+    auto result = callable->call(
+        frame.scope, ArgsSpan(stack_.data() + callee_index + 1, args_count));
+    stack_.resize(callee_index);
+    stack_.push_back(std::move(result));
+    return;
+  }
+
+  auto scope = compiled->create_frame(
+      ArgsSpan(stack_.data() + callee_index + 1, args_count));
+  auto code = compiled->get_code();
+  if (tail) {
+    stack_.resize(frame.stack_base);
+    frame.code = code;
+    frame.pc = 0;
+    frame.scope = scope;
+  } else {
+    stack_.resize(callee_index);
+    frames_.push_back(Frame{code, 0, scope, stack_.size()});
+  }
+}
+
+} // lispp
@@ -0,0 +1,139 @@
+#include <lispp/isolate_pool.h>
+
+#include <algorithm>
+
+#include <lispp/cycle_collector.h>
+
+namespace lispp {
+
+namespace {
+
+  struct CurrentWorker {
+    const IsolatePool* pool = nullptr;
+    std::size_t index = 0;
+  };
+
+  thread_local CurrentWorker current_worker;
+
+} // namespace
+
+IsolatePool::IsolatePool(std::size_t threads_count) {
+  if (threads_count == 0) {
+    threads_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  for (std::size_t index = 0; index < threads_count; ++index) {
+    queues_.emplace_back(new TaskQueue);
+  }
+
+  workers_.reserve(threads_count);
+  for (std::size_t index = 0; index < threads_count; ++index) {
+    workers_.emplace_back(&IsolatePool::run_worker, this, index);
+  }
+}
+
+IsolatePool::~IsolatePool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  has_tasks_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::future<std::string> IsolatePool::eval(const std::string& code) {
+  return submit([code](VirtualMachine<>& vm) {
+    auto result = vm.eval_all(code);
+    return (result.valid() ? result->to_string() : std::string("()"));
+  });
+}
+
+bool IsolatePool::is_current_worker() const {
+  return current_worker.pool == this;
+}
+
+void IsolatePool::push_task(IsolatedTask task) {
+  const std::size_t queue_index =
+      (current_worker.pool == this
+       ? current_worker.index
+       : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size());
+  {
+    TaskQueue& queue = *queues_[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_count_;
+  }
+  has_tasks_.notify_one();
+}
+
+bool IsolatePool::pop_task(std::size_t worker_index, IsolatedTask* task) {
+  {
+    TaskQueue& queue = *queues_[worker_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+    TaskQueue& queue = *queues_[(worker_index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      steals_count_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void IsolatePool::run_worker(std::size_t worker_index) {
+  current_worker.pool = this;
+  current_worker.index = worker_index;
+
+  while (true) {
+    IsolatedTask task;
+    if (!pop_task(worker_index, &task)) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // NOTE: the task counted as pending may be taken by another worker
+      //       right now, then the queues are searched once again
+      has_tasks_.wait(lock, [this] {
+        return stopping_ || pending_count_ > 0;
+      });
+      if (stopping_ && pending_count_ == 0) {
+        return;
+      }
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --pending_count_;
+    }
+
+    {
+      VirtualMachine<> vm;
+      task(vm);
+    }
+
+    // NOTE: frees the cycles left by the isolate (e.g. global functions
+    //       referring to the global scope)
+    auto& collector = CycleCollector::get_current();
+    if (collector.get_tracked_count() > 0) {
+      collector.collect();
+    }
+  }
+}
+
+} // lispp
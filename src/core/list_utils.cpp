@@ -1,5 +1,7 @@
 #include <lispp/list_utils.h>
 
+#include <iterator>
+
 namespace lispp {
 
 std::vector<ObjectPtr<>> unpack_list(const ObjectPtr<>& lst) {
@@ -33,17 +35,16 @@ ObjectPtr<> unpack_list(const ObjectPtr<>& lst, int num_values,
   return tail;
 }
 
-ObjectPtr<> pack_list(const std::vector<ObjectPtr<>>& lst,
-                      const ObjectPtr<>& rest) {
+ObjectPtr<> pack_list(ArgsSpan lst, const ObjectPtr<>& rest) {
   ObjectPtr<> result = rest;
-  for (auto it = lst.rbegin(); it != lst.rend(); ++it) {
-    ObjectPtr<ConsObject> new_head(new ConsObject(*it, result));
+  for (auto it = lst.end(); it != lst.begin(); --it) {
+    ObjectPtr<ConsObject> new_head(new ConsObject(*std::prev(it), result));
     result = new_head;
   }
   return result;
 }
 
-ObjectPtr<> pack_list(const std::vector<ObjectPtr<>>& lst) {
+ObjectPtr<> pack_list(ArgsSpan lst) {
   return pack_list(lst, nullptr);
 }
 
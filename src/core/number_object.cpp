@@ -0,0 +1,46 @@
+#include <lispp/number_object.h>
+
+#include <cmath>
+#include <vector>
+
+namespace lispp {
+
+constexpr int NumberObject::kSmallIntegerMin;
+constexpr int NumberObject::kSmallIntegerMax;
+
+namespace {
+
+  std::vector<ObjectPtr<NumberObject>> make_small_integers() {
+    std::vector<ObjectPtr<NumberObject>> small_integers;
+    small_integers.reserve(NumberObject::kSmallIntegerMax -
+                           NumberObject::kSmallIntegerMin + 1);
+    for (int value = NumberObject::kSmallIntegerMin;
+         value <= NumberObject::kSmallIntegerMax; ++value) {
+      auto* number = new NumberObject(value);
+      number->make_immortal();
+      small_integers.emplace_back(number);
+    }
+
+    return small_integers;
+  }
+
+} // namespace
+
+ObjectPtr<NumberObject> NumberObject::make(double value) {
+  static const std::vector<ObjectPtr<NumberObject>> kSmallIntegers =
+      make_small_integers();
+
+  // NOTE: NaN fails both comparisons. Negative zero equals the shared
+  //       zero, but it's another number (e.g. 1 / -0 is -inf)
+  if (value >= kSmallIntegerMin && value <= kSmallIntegerMax &&
+      !(value == 0 && std::signbit(value))) {
+    const int int_value = static_cast<int>(value);
+    if (int_value == value) {
+      return kSmallIntegers[int_value - kSmallIntegerMin];
+    }
+  }
+
+  return new NumberObject(value);
+}
+
+} // lispp
@@ -1,5 +1,7 @@
 #include <lispp/object.h>
 
+#include <lispp/release_queue.h>
+
 namespace lispp {
 
 Object::~Object() { }
@@ -12,21 +14,8 @@ int Object::get_ref_count() const {
   return ref_count_;
 }
 
-int Object::ref() {
-  return ++ref_count_;
-}
-
-int Object::unref() {
-  const int result = unref_nodelete();
-  if (result == 0) {
-    delete this;
-  }
-  return result;
-}
-
-int Object::unref_nodelete() {
-  assert(ref_count_ > 0);
-  return --ref_count_;
+void Object::destroy() {
+  ReleaseQueue::release(this);
 }
 
 std::ostream& operator<<(std::ostream& out, const Object& obj) {
@@ -0,0 +1,250 @@
+#include <lispp/object_pool.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#include <sanitizer/lsan_interface.h>
+#endif
+
+namespace lispp {
+
+namespace {
+
+  constexpr std::size_t kGranularity = 16;
+  constexpr std::size_t kMaxBlockSize = 128;
+  constexpr std::size_t kSizeClassesCount = kMaxBlockSize / kGranularity;
+  constexpr std::size_t kSlabSize = 64 * 1024;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // NOTE: Free blocks are poisoned under AddressSanitizer, so it still
+  //       catches use-after-free of pooled objects. The links of free
+  //       blocks are unpoisoned only while the pool reads or writes them
+  void poison(void* block, std::size_t size) {
+#if defined(__SANITIZE_ADDRESS__)
+    ASAN_POISON_MEMORY_REGION(block, size);
+#else
+    (void)block;
+    (void)size;
+#endif
+  }
+
+  void unpoison(void* block, std::size_t size) {
+#if defined(__SANITIZE_ADDRESS__)
+    ASAN_UNPOISON_MEMORY_REGION(block, size);
+#else
+    (void)block;
+    (void)size;
+#endif
+  }
+
+  FreeBlock* get_next(FreeBlock* block) {
+    unpoison(block, sizeof(FreeBlock));
+    FreeBlock* next = block->next;
+    poison(block, sizeof(FreeBlock));
+    return next;
+  }
+
+  void set_next(FreeBlock* block, FreeBlock* next) {
+    unpoison(block, sizeof(FreeBlock));
+    block->next = next;
+    poison(block, sizeof(FreeBlock));
+  }
+
+  std::size_t get_size_class(std::size_t size) {
+    return (size + kGranularity - 1) / kGranularity - 1;
+  }
+
+  std::size_t get_block_size(std::size_t size_class) {
+    return (size_class + 1) * kGranularity;
+  }
+
+  FreeBlock* get_last_block(FreeBlock* block) {
+    for (FreeBlock* next = get_next(block); next != nullptr;
+         next = get_next(block)) {
+      block = next;
+    }
+    return block;
+  }
+
+  std::atomic<ObjectAllocatorType> allocator_type(ObjectAllocatorType::kPool);
+  std::atomic<bool> has_slabs(false);
+
+  // NOTE: Blocks of exited threads. Never destroyed: objects may be freed
+  //       during static destruction
+  struct SharedFreeLists {
+    std::mutex mutex;
+    FreeBlock* free_lists[kSizeClassesCount] = {};
+  };
+
+  SharedFreeLists& get_shared_free_lists() {
+    static SharedFreeLists* shared_free_lists = new SharedFreeLists;
+    return *shared_free_lists;
+  }
+
+  void push_shared(std::size_t size_class, FreeBlock* first, FreeBlock* last) {
+    auto& shared = get_shared_free_lists();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    set_next(last, shared.free_lists[size_class]);
+    shared.free_lists[size_class] = first;
+  }
+
+  FreeBlock* pop_shared(std::size_t size_class) {
+    auto& shared = get_shared_free_lists();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    FreeBlock* result = shared.free_lists[size_class];
+    shared.free_lists[size_class] = nullptr;
+    return result;
+  }
+
+  thread_local bool local_free_lists_destroyed = false;
+
+  struct LocalFreeLists {
+    ~LocalFreeLists() {
+      for (std::size_t size_class = 0; size_class < kSizeClassesCount;
+           ++size_class) {
+        if (free_lists[size_class] != nullptr) {
+          push_shared(size_class, free_lists[size_class],
+                      get_last_block(free_lists[size_class]));
+        }
+      }
+      local_free_lists_destroyed = true;
+    }
+
+    FreeBlock* free_lists[kSizeClassesCount] = {};
+    // NOTE: blocks freed minus blocks allocated by the thread (not less
+    //       than 0), the free list has at least that many blocks
+    std::size_t balances[kSizeClassesCount] = {};
+  };
+
+  thread_local LocalFreeLists local_free_lists;
+
+  // NOTE: Blocks freed by one thread may be needed by another one (e.g.
+  //       the objects parsed by workers are freed by the caller, see
+  //       ParallelParser). So when a thread frees a slab of blocks more
+  //       than it allocates, they are moved to the shared free lists
+  void share_freed_blocks(std::size_t size_class) {
+    const std::size_t blocks_count = kSlabSize / get_block_size(size_class);
+    std::size_t& balance = local_free_lists.balances[size_class];
+    if (balance < blocks_count) {
+      return;
+    }
+
+    FreeBlock*& free_list = local_free_lists.free_lists[size_class];
+    FreeBlock* first = free_list;
+    FreeBlock* last = first;
+    for (std::size_t index = 1; index < blocks_count; ++index) {
+      last = get_next(last);
+    }
+    free_list = get_next(last);
+    set_next(last, nullptr);
+    balance -= blocks_count;
+
+    push_shared(size_class, first, last);
+  }
+
+  FreeBlock* allocate_slab(std::size_t size_class) {
+    has_slabs = true;
+
+    const std::size_t block_size = get_block_size(size_class);
+    const std::size_t blocks_count = kSlabSize / block_size;
+    char* slab = static_cast<char*>(::operator new(kSlabSize));
+
+    for (std::size_t block_index = 0; block_index + 1 < blocks_count;
+         ++block_index) {
+      reinterpret_cast<FreeBlock*>(slab + block_index * block_size)->next =
+          reinterpret_cast<FreeBlock*>(slab + (block_index + 1) * block_size);
+    }
+    reinterpret_cast<FreeBlock*>(
+        slab + (blocks_count - 1) * block_size)->next = nullptr;
+    poison(slab, kSlabSize);
+#if defined(__SANITIZE_ADDRESS__)
+    // NOTE: slabs are never freed, and the only references to them may be
+    //       the links in poisoned free blocks, which LeakSanitizer skips
+    __lsan_ignore_object(slab);
+#endif
+
+    return reinterpret_cast<FreeBlock*>(slab);
+  }
+
+} // namespace
+
+void* ObjectPool::allocate(std::size_t size) {
+  if (size > kMaxBlockSize) {
+    return ::operator new(size);
+  }
+
+  const std::size_t size_class = get_size_class(size);
+  if (allocator_type.load(std::memory_order_relaxed) ==
+      ObjectAllocatorType::kSystem || local_free_lists_destroyed) {
+    // NOTE: the whole block, so it can be reused by the pool later
+    return ::operator new(get_block_size(size_class));
+  }
+
+  FreeBlock*& free_list = local_free_lists.free_lists[size_class];
+  if (free_list == nullptr) {
+    free_list = pop_shared(size_class);
+    if (free_list == nullptr) {
+      free_list = allocate_slab(size_class);
+    }
+  }
+
+  std::size_t& balance = local_free_lists.balances[size_class];
+  if (balance > 0) {
+    --balance;
+  }
+
+  FreeBlock* block = free_list;
+  free_list = get_next(block);
+  unpoison(block, size);
+  return block;
+}
+
+void ObjectPool::deallocate(void* ptr, std::size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  if (size > kMaxBlockSize ||
+      allocator_type.load(std::memory_order_relaxed) ==
+      ObjectAllocatorType::kSystem) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  const std::size_t size_class = get_size_class(size);
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  poison(block, get_block_size(size_class));
+  if (local_free_lists_destroyed) {
+    set_next(block, nullptr);
+    push_shared(size_class, block, block);
+    return;
+  }
+
+  FreeBlock*& free_list = local_free_lists.free_lists[size_class];
+  set_next(block, free_list);
+  free_list = block;
+
+  ++local_free_lists.balances[size_class];
+  share_freed_blocks(size_class);
+}
+
+ObjectAllocatorType ObjectPool::get_allocator_type() {
+  return allocator_type;
+}
+
+bool ObjectPool::set_allocator_type(ObjectAllocatorType type) {
+  if (type == ObjectAllocatorType::kSystem && has_slabs) {
+    return false;
+  }
+
+  allocator_type = type;
+  return true;
+}
+
+} // lispp
@@ -0,0 +1,441 @@
+#include <lispp/object_snapshot.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include <lispp/compiled_callable_object.h>
+#include <lispp/objects_all.h>
+
+namespace lispp {
+
+constexpr std::size_t ObjectSnapshot::kNil;
+
+// NOTE: Adds nodes in the order of discovery and fills their children
+//       from the explicit stack (long lists take constant native stack)
+class ObjectSnapshot::Builder {
+public:
+  explicit Builder(std::vector<Node>* nodes) : nodes_(*nodes) {}
+
+  std::size_t add(const ObjectPtr<>& object) {
+    Object* raw_object = object.get();
+    if (raw_object == nullptr) {
+      return kNil;
+    }
+
+    auto index_it = indices_.find(raw_object);
+    if (index_it != indices_.end()) {
+      return index_it->second;
+    }
+
+    if (raw_object->is_immortal()) {
+      if (raw_object->as_symbol() != nullptr) {
+        referenced_names_.insert(raw_object->as_symbol()->get_id());
+      }
+      const std::size_t index = add_node(raw_object, NodeType::kShared);
+      nodes_[index].shared_object = raw_object;
+      return index;
+    }
+
+    if (raw_object->as_number() != nullptr) {
+      const std::size_t index = add_node(raw_object, NodeType::kNumber);
+      nodes_[index].number_value = raw_object->as_number()->get_value();
+      return index;
+    }
+
+    if (raw_object->as_characters() != nullptr) {
+      const std::size_t index = add_node(raw_object, NodeType::kCharacters);
+      nodes_[index].string_value = raw_object->as_characters()->get_value();
+      return index;
+    }
+
+    NodeType type;
+    if (raw_object->as_cons() != nullptr) {
+      type = NodeType::kCons;
+    } else if (raw_object->as_quote() != nullptr) {
+      type = NodeType::kQuote;
+    } else if (raw_object->as_comma() != nullptr) {
+      type = NodeType::kComma;
+    } else if (raw_object->as_back_tick() != nullptr) {
+      type = NodeType::kBackTick;
+    } else if (raw_object->as<CompiledCallableObject>() != nullptr) {
+      type = NodeType::kCompiledCallable;
+    } else if (raw_object->as<UserCallableObject>() != nullptr) {
+      type = NodeType::kUserCallable;
+    } else {
+      throw ExecutionError("Cannot copy " + raw_object->to_string() +
+                           " to another isolate");
+    }
+
+    const std::size_t index = add_node(raw_object, type);
+    pending_objects_.emplace_back(index, raw_object);
+    return index;
+  }
+
+  std::size_t add_scope(Scope* scope) {
+    if (scope == nullptr) {
+      return kNil;
+    }
+
+    auto index_it = indices_.find(scope);
+    if (index_it != indices_.end()) {
+      return index_it->second;
+    }
+
+    if (scope->is_frozen()) {
+      const std::size_t index = add_node(scope, NodeType::kFrozenScope);
+      nodes_[index].frozen_scope = scope;
+      return index;
+    }
+
+    const std::size_t index = add_node(scope, NodeType::kScope);
+    nodes_[index].slot_names = scope->get_slot_names();
+    pending_scopes_.emplace_back(index, scope);
+    return index;
+  }
+
+  std::size_t add_lambda(const std::shared_ptr<LambdaTemplate>& lambda) {
+    auto index_it = indices_.find(lambda.get());
+    if (index_it != indices_.end()) {
+      return index_it->second;
+    }
+
+    const std::size_t index = add_node(lambda.get(), NodeType::kLambdaTemplate);
+    auto blueprint = std::make_shared<LambdaTemplate>();
+    blueprint->name = lambda->name;
+    blueprint->args_count = lambda->args_count;
+    blueprint->has_rest_arg = lambda->has_rest_arg;
+    blueprint->slot_names = lambda->slot_names;
+    for (const auto& frame : lambda->enclosing_frames) {
+      blueprint->enclosing_frames.push_back(copy_frame(frame));
+    }
+    nodes_[index].lambda = blueprint;
+    pending_lambdas_.emplace_back(index, lambda.get());
+    return index;
+  }
+
+  void build() {
+    do {
+      build_pending();
+    } while (add_referenced_values());
+  }
+
+private:
+  void build_pending() {
+    while (!pending_objects_.empty() || !pending_scopes_.empty() ||
+           !pending_lambdas_.empty()) {
+      if (!pending_objects_.empty()) {
+        auto pending = pending_objects_.back();
+        pending_objects_.pop_back();
+        fill_object(pending.first, pending.second);
+      } else if (!pending_scopes_.empty()) {
+        auto pending = pending_scopes_.back();
+        pending_scopes_.pop_back();
+        fill_scope(pending.first, pending.second);
+      } else {
+        auto pending = pending_lambdas_.back();
+        pending_lambdas_.pop_back();
+        std::vector<std::size_t> children;
+        for (const auto& form : pending.second->body) {
+          children.push_back(add(form));
+        }
+        nodes_[pending.first].children = std::move(children);
+      }
+    }
+  }
+
+  // NOTE: Named values (globals) are copied only if their names occur in
+  //       the copied objects, otherwise the whole global scope would be
+  //       copied with every closure. Returns false if nothing is added
+  bool add_referenced_values() {
+    bool added = false;
+    for (auto& named_scope : named_scopes_) {
+      std::vector<std::pair<SymbolId, std::size_t>> named_values;
+      named_scope.scope->for_each_named_value(
+          [this, &named_scope, &named_values](SymbolId name,
+                                              const ObjectPtr<>& value) {
+            if (referenced_names_.count(name) != 0 &&
+                named_scope.copied_names.insert(name).second) {
+              named_values.emplace_back(name, add(value));
+            }
+          });
+
+      auto& node_values = nodes_[named_scope.index].named_values;
+      node_values.insert(node_values.end(), named_values.begin(),
+                         named_values.end());
+      added = added || !named_values.empty();
+    }
+    return added;
+  }
+
+  std::size_t add_node(const void* source, NodeType type) {
+    nodes_.emplace_back(type);
+    indices_.emplace(source, nodes_.size() - 1);
+    return nodes_.size() - 1;
+  }
+
+  // NOTE: copies of the layouts are shared as the originals are
+  std::shared_ptr<FrameLayout> copy_frame(
+      const std::shared_ptr<FrameLayout>& frame) {
+    auto frame_it = frames_.find(frame.get());
+    if (frame_it != frames_.end()) {
+      return frame_it->second;
+    }
+
+    auto result = std::make_shared<FrameLayout>(frame->slot_names);
+    result->defined_names = frame->defined_names;
+    frames_.emplace(frame.get(), result);
+    return result;
+  }
+
+  void fill_object(std::size_t index, Object* object) {
+    std::vector<std::size_t> children;
+    switch (nodes_[index].type) {
+      case NodeType::kCons:
+        children.push_back(add(object->as_cons()->get_left_value()));
+        children.push_back(add(object->as_cons()->get_right_value()));
+        break;
+      case NodeType::kQuote:
+        children.push_back(add(object->as_quote()->get_value()));
+        break;
+      case NodeType::kComma:
+        children.push_back(add(object->as_comma()->get_value()));
+        break;
+      case NodeType::kBackTick:
+        children.push_back(add(object->as_back_tick()->get_value()));
+        break;
+      case NodeType::kCompiledCallable: {
+        auto* callable = object->as<CompiledCallableObject>();
+        children.push_back(add_lambda(callable->get_lambda()));
+        children.push_back(add_scope(callable->get_closure().get()));
+        break;
+      }
+      case NodeType::kUserCallable: {
+        auto* callable = object->as<UserCallableObject>();
+        children.push_back(add_scope(callable->get_closure().get()));
+        for (const auto& form : callable->get_body()) {
+          children.push_back(add(form));
+        }
+        Node& node = nodes_[index];
+        node.string_value = callable->get_name();
+        node.args = callable->get_args();
+        node.rest_arg_name = callable->get_rest_arg_name();
+        node.callable_type = callable->get_type();
+        break;
+      }
+      default:
+        break;
+    }
+    nodes_[index].children = std::move(children);
+  }
+
+  void fill_scope(std::size_t index, Scope* scope) {
+    std::vector<std::size_t> children;
+    children.push_back(add_scope(scope->get_parent_scope().get()));
+    for (std::size_t slot = 0; slot < scope->get_slots_count(); ++slot) {
+      children.push_back(add(scope->get_slot(slot)));
+    }
+    nodes_[index].children = std::move(children);
+
+    NamedScope named_scope;
+    named_scope.index = index;
+    named_scope.scope = scope;
+    named_scopes_.push_back(std::move(named_scope));
+  }
+
+  struct NamedScope {
+    std::size_t index;
+    Scope* scope;
+    std::unordered_set<SymbolId> copied_names;
+  };
+
+  std::vector<Node>& nodes_;
+  std::unordered_map<const void*, std::size_t> indices_;
+  std::unordered_map<const FrameLayout*,
+                     std::shared_ptr<FrameLayout>> frames_;
+  std::vector<std::pair<std::size_t, Object*>> pending_objects_;
+  std::vector<std::pair<std::size_t, Scope*>> pending_scopes_;
+  std::vector<std::pair<std::size_t, LambdaTemplate*>> pending_lambdas_;
+  std::vector<NamedScope> named_scopes_;
+  std::unordered_set<SymbolId> referenced_names_;
+};
+
+// NOTE: Creates the objects first (callables after scopes and templates
+//       they need) and links them afterwards, so cycles are restored too
+class ObjectSnapshot::Restorer {
+public:
+  explicit Restorer(const std::vector<Node>& nodes)
+      : nodes_(nodes), objects_(nodes.size()), scopes_(nodes.size()),
+      lambdas_(nodes.size()) {}
+
+  void restore() {
+    for (std::size_t index = 0; index < nodes_.size(); ++index) {
+      create(index);
+    }
+    for (std::size_t index = 0; index < nodes_.size(); ++index) {
+      create_callable(index);
+    }
+    for (std::size_t index = 0; index < nodes_.size(); ++index) {
+      link(index);
+    }
+  }
+
+  const ObjectPtr<>& get(std::size_t index) const {
+    static const ObjectPtr<> kNilObject;
+    return (index == kNil ? kNilObject : objects_[index]);
+  }
+
+private:
+  void create(std::size_t index) {
+    const Node& node = nodes_[index];
+    switch (node.type) {
+      case NodeType::kShared:
+        objects_[index] = node.shared_object;
+        break;
+      case NodeType::kFrozenScope:
+        scopes_[index] = ScopePtr(node.frozen_scope);
+        break;
+      case NodeType::kNumber:
+        objects_[index] = ObjectPtr<>(NumberObject::make(node.number_value));
+        break;
+      case NodeType::kCharacters:
+        objects_[index] = new CharactersObject(node.string_value);
+        break;
+      case NodeType::kCons:
+        objects_[index] = new ConsObject;
+        break;
+      case NodeType::kQuote:
+        objects_[index] = new QuoteObject;
+        break;
+      case NodeType::kComma:
+        objects_[index] = new CommaObject;
+        break;
+      case NodeType::kBackTick:
+        objects_[index] = new BackTickObject;
+        break;
+      case NodeType::kScope:
+        create_scope(index);
+        break;
+      case NodeType::kLambdaTemplate: {
+        auto lambda = std::make_shared<LambdaTemplate>();
+        lambda->name = node.lambda->name;
+        lambda->args_count = node.lambda->args_count;
+        lambda->has_rest_arg = node.lambda->has_rest_arg;
+        lambda->slot_names = node.lambda->slot_names;
+        lambda->enclosing_frames = node.lambda->enclosing_frames;
+        lambdas_[index] = lambda;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  // NOTE: parents are created first
+  void create_scope(std::size_t index) {
+    std::vector<std::size_t> chain;
+    for (std::size_t current = index;
+         current != kNil && !scopes_[current];
+         current = nodes_[current].children[0]) {
+      if (nodes_[current].type == NodeType::kFrozenScope) {
+        scopes_[current] = ScopePtr(nodes_[current].frozen_scope);
+        break;
+      }
+      chain.push_back(current);
+    }
+
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      const Node& node = nodes_[*it];
+      const std::size_t parent = node.children[0];
+      ScopePtr parent_scope = (parent == kNil ? nullptr : scopes_[parent]);
+      scopes_[*it] = (node.slot_names != nullptr
+                      ? Scope::create_frame(parent_scope, node.slot_names)
+                      : ScopePtr(new Scope(parent_scope)));
+    }
+  }
+
+  void create_callable(std::size_t index) {
+    const Node& node = nodes_[index];
+    if (node.type == NodeType::kCompiledCallable) {
+      objects_[index] = new CompiledCallableObject(
+          lambdas_[node.children[0]], get_scope(node.children[1]));
+    } else if (node.type == NodeType::kUserCallable) {
+      std::vector<ObjectPtr<>> body;
+      for (std::size_t child = 1; child < node.children.size(); ++child) {
+        body.push_back(get(node.children[child]));
+      }
+      objects_[index] = new UserCallableObject(
+          node.string_value, node.args, body, get_scope(node.children[0]),
+          node.rest_arg_name, node.callable_type);
+    }
+  }
+
+  void link(std::size_t index) {
+    const Node& node = nodes_[index];
+    switch (node.type) {
+      case NodeType::kCons:
+        objects_[index]->as_cons()->set_left_value(get(node.children[0]));
+        objects_[index]->as_cons()->set_right_value(get(node.children[1]));
+        break;
+      case NodeType::kQuote:
+        objects_[index]->as_quote()->set_value(get(node.children[0]));
+        break;
+      case NodeType::kComma:
+        objects_[index]->as_comma()->set_value(get(node.children[0]));
+        break;
+      case NodeType::kBackTick:
+        objects_[index]->as_back_tick()->set_value(get(node.children[0]));
+        break;
+      case NodeType::kScope: {
+        const ScopePtr& scope = scopes_[index];
+        for (std::size_t child = 1; child < node.children.size(); ++child) {
+          scope->set_slot(child - 1, get(node.children[child]));
+        }
+        for (const auto& value : node.named_values) {
+          scope->set_value(value.first, get(value.second));
+        }
+        break;
+      }
+      case NodeType::kLambdaTemplate:
+        for (std::size_t child : node.children) {
+          lambdas_[index]->body.push_back(get(child));
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  ScopePtr get_scope(std::size_t index) const {
+    return (index == kNil ? nullptr : scopes_[index]);
+  }
+
+  const std::vector<Node>& nodes_;
+  std::vector<ObjectPtr<>> objects_;
+  std::vector<ScopePtr> scopes_;
+  std::vector<std::shared_ptr<LambdaTemplate>> lambdas_;
+};
+
+ObjectSnapshot ObjectSnapshot::take(ArgsSpan roots) {
+  ObjectSnapshot snapshot;
+  Builder builder(&snapshot.nodes_);
+  for (const auto& root : roots) {
+    snapshot.roots_.push_back(builder.add(root));
+  }
+  builder.build();
+
+  return snapshot;
+}
+
+std::vector<ObjectPtr<>> ObjectSnapshot::restore() const {
+  Restorer restorer(nodes_);
+  restorer.restore();
+
+  std::vector<ObjectPtr<>> result;
+  result.reserve(roots_.size());
+  for (std::size_t root : roots_) {
+    result.push_back(restorer.get(root));
+  }
+  return result;
+}
+
+} // lispp
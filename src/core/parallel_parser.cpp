@@ -0,0 +1,185 @@
+#include <lispp/parallel_parser.h>
+
+#include <algorithm>
+#include <deque>
+
+#include <lispp/buffer_tokenizer.h>
+#include <lispp/char_classes.h>
+#include <lispp/parser.h>
+
+namespace lispp {
+
+namespace {
+
+  // NOTE: a quote, a comma or a back tick before the position belongs to
+  //       the form after it
+  bool is_prefixed(const char* begin, const char* position) {
+    while (position != begin &&
+           kCharClasses.is(position[-1], kWhiteSpace | kLineEnd)) {
+      --position;
+    }
+
+    return position != begin && kCharClasses.is(position[-1], kPrefix);
+  }
+
+} // namespace
+
+constexpr std::size_t ParallelParser::kDefaultChunkSize;
+constexpr std::size_t ParallelParser::kChunksPerWorker;
+
+ParallelParser::ParallelParser(IsolatePool* pool, std::size_t chunk_size)
+    : pool_(pool), chunk_size_(std::max<std::size_t>(chunk_size, 1)) {}
+
+void ParallelParser::parse_all(const char* data, std::size_t size,
+                               const FormHandler& handler) {
+  current_line_ = 0;
+  const std::vector<Chunk> chunks = split(data, size, chunk_size_);
+  if (chunks.size() <= 1 || pool_->is_current_worker()) {
+    // NOTE: workers must not wait for the pool
+    for (const Chunk& chunk : chunks) {
+      ChunkResult result = parse_chunk(data, chunk);
+      handle_result(&result, handler);
+    }
+    return;
+  }
+
+  const std::size_t max_pending_count =
+      pool_->get_threads_count() * kChunksPerWorker;
+  std::deque<std::future<ChunkResult>> pending_results;
+  std::size_t next_chunk_index = 1;
+  auto submit_chunks = [&]() {
+    while (next_chunk_index < chunks.size() &&
+           pending_results.size() < max_pending_count) {
+      const Chunk chunk = chunks[next_chunk_index++];
+      pending_results.push_back(
+          pool_->submit([data, chunk](VirtualMachine<>&) {
+            return parse_chunk(data, chunk);
+          }));
+    }
+  };
+
+  try {
+    submit_chunks();
+    ChunkResult result = parse_chunk(data, chunks.front());
+    handle_result(&result, handler);
+
+    while (!pending_results.empty()) {
+      result = pending_results.front().get();
+      pending_results.pop_front();
+      submit_chunks();
+      handle_result(&result, handler);
+    }
+  } catch (...) {
+    // NOTE: the pool still reads the text
+    for (auto& pending_result : pending_results) {
+      pending_result.wait();
+    }
+    throw;
+  }
+}
+
+std::vector<ObjectPtr<>> ParallelParser::parse_all(const char* data,
+                                                   std::size_t size) {
+  std::vector<ObjectPtr<>> forms;
+  parse_all(data, size, [&forms](const ObjectPtr<>& form) {
+    forms.push_back(form);
+  });
+
+  return forms;
+}
+
+// NOTE: Chunks are cut after at least chunk_size chars at the ends of
+//       lines and after the lists out of lists and strings (tokens other
+//       than strings can't contain brackets and line ends), but not after
+//       quotes, commas and back ticks. Unbalanced closing brackets and
+//       unterminated strings stop the cutting: the rest of the text is one
+//       chunk, which fails as it does on sequential parsing
+std::vector<ParallelParser::Chunk> ParallelParser::split(
+    const char* data, std::size_t size, std::size_t chunk_size) {
+  std::vector<Chunk> chunks;
+  Chunk chunk;
+  int depth = 0;
+  int line = 0;
+  auto cut = [&](std::size_t position) {
+    if (depth == 0 && position - chunk.begin >= chunk_size &&
+        !is_prefixed(data + chunk.begin, data + position)) {
+      chunk.end = position;
+      chunks.push_back(chunk);
+      chunk.begin = position;
+      chunk.first_line = line;
+    }
+  };
+
+  const char* const end = data + size;
+  for (const char* current = data; current != end; ++current) {
+    current = skip_to_scan_stop(current, end);
+    if (current == end) {
+      break;
+    }
+
+    switch (*current) {
+      case '(':
+        ++depth;
+        break;
+      case ')':
+        --depth;
+        cut(current + 1 - data);
+        break;
+      case '"':
+        current = skip_to_quotes(current + 1, end);
+        if (current == end) {
+          --current;
+          // NOTE: no more cuts
+          depth = -1;
+        }
+        break;
+      case '\n':
+        cut(current - data);
+        ++line;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (chunk.begin < size) {
+    chunk.end = size;
+    chunks.push_back(chunk);
+  }
+
+  return chunks;
+}
+
+ParallelParser::ChunkResult ParallelParser::parse_chunk(const char* data,
+                                                        const Chunk& chunk) {
+  BufferTokenizer tokenizer(data + chunk.begin, chunk.end - chunk.begin);
+  Parser parser(&tokenizer);
+
+  ChunkResult result;
+  try {
+    while (parser.has_objects()) {
+      result.forms.push_back(parser.parse_object());
+    }
+  } catch (...) {
+    result.error = std::current_exception();
+  }
+  result.end_line = chunk.first_line + tokenizer.get_current_line();
+
+  return result;
+}
+
+void ParallelParser::handle_result(ChunkResult* result,
+                                   const FormHandler& handler) {
+  for (auto& form : result->forms) {
+    handler(form);
+    // NOTE: handled forms are not kept until the end of the chunk
+    form.reset();
+  }
+
+  current_line_ = result->end_line;
+  if (result->error) {
+    std::rethrow_exception(result->error);
+  }
+}
+
+} // lispp
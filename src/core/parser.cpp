@@ -19,74 +19,121 @@ bool Parser::has_objects(bool ignore_endlines) {
 }
 
 ObjectPtr<> Parser::parse_object() {
+  frames_.clear();
+  ObjectPtr<> object;
+
+  while (true) {
+    if (!read_object(&object)) {
+      continue;
+    }
+
+    while (!frames_.empty() && add_to_frame(&frames_.back(), &object)) {
+      frames_.pop_back();
+    }
+
+    if (frames_.empty()) {
+      return object;
+    }
+  }
+}
+
+bool Parser::read_object(ObjectPtr<>* object) {
   skip_endlines();
-  const auto current_token = tokenizer_->next_token();
+  if (!frames_.empty() && frames_.back().type == Frame::Type::kList &&
+      tokenizer_->peek_token().type == TokenType::kCloseBracket) {
+    tokenizer_->next_token();
+    *object = ObjectPtr<>(frames_.back().head);
+    frames_.pop_back();
+    return true;
+  }
+
+  const Token& current_token = tokenizer_->next_token();
 
   if (current_token.type == TokenType::kNumber) {
-    double value = current_token.number_value;
-    return new NumberObject(value);
+    *object = ObjectPtr<>(NumberObject::make(current_token.number_value));
 
   } else if (current_token.type == TokenType::kCharacters) {
-    std::string value = current_token.string_value;
-    return new CharactersObject(value);
+    *object = new CharactersObject(current_token.get_text());
 
   } else if (current_token.type == TokenType::kSymbol) {
-    std::string value = current_token.string_value;
-    if (value == "#t") {
-      return new BooleanObject(true);
-    } else if (value == "#f") {
-      return new BooleanObject(false);
+    if (current_token.text_equals("#t")) {
+      *object = ObjectPtr<>(BooleanObject::make(true));
+    } else if (current_token.text_equals("#f")) {
+      *object = ObjectPtr<>(BooleanObject::make(false));
     } else {
-      return new SymbolObject(value);
+      *object = ObjectPtr<>(SymbolObject::intern(current_token.text,
+                                                 current_token.text_size));
     }
 
   } else if (current_token.type == TokenType::kQuote) {
-    ObjectPtr<> underlying_object(parse_object());
-    return new QuoteObject(underlying_object);
+    frames_.emplace_back(Frame::Type::kQuote);
+    return false;
 
   } else if (current_token.type == TokenType::kComma) {
-    ObjectPtr<> underlying_object(parse_object());
-    return new CommaObject(underlying_object);
+    frames_.emplace_back(Frame::Type::kComma);
+    return false;
 
   } else if (current_token.type == TokenType::kBackTick) {
-    ObjectPtr<> underlying_object(parse_object());
-    return new BackTickObject(underlying_object);
+    frames_.emplace_back(Frame::Type::kBackTick);
+    return false;
 
   } else if (current_token.type == TokenType::kOpenBracket) {
-    return parse_begun_list();
+    frames_.emplace_back(Frame::Type::kList);
+    return false;
 
   } else if (current_token.type == TokenType::kEnd) {
-    return nullptr;
+    *object = nullptr;
 
+  } else {
+    std::stringstream ss;
+    ss << "Unexpected token: " << current_token;
+    throw ParserError(ss.str());
   }
 
-  std::stringstream ss;
-  ss << "Unexpected token: " << current_token;
-  throw ParserError(ss.str());
+  return true;
 }
 
-ObjectPtr<ConsObject> Parser::parse_begun_list() {
-  skip_endlines();
-  if (tokenizer_->peek_token().type == TokenType::kCloseBracket) {
-    tokenizer_->next_token();
-    return nullptr;
+bool Parser::add_to_frame(Frame* frame, ObjectPtr<>* object) {
+  switch (frame->type) {
+    case Frame::Type::kQuote:
+      *object = new QuoteObject(*object);
+      return true;
+
+    case Frame::Type::kComma:
+      *object = new CommaObject(*object);
+      return true;
+
+    case Frame::Type::kBackTick:
+      *object = new BackTickObject(*object);
+      return true;
+
+    case Frame::Type::kListTail:
+      frame->tail->set_right_value(*object);
+      expect_token(Token(TokenType::kCloseBracket), true);
+      *object = ObjectPtr<>(frame->head);
+      return true;
+
+    case Frame::Type::kList:
+      break;
   }
 
-  ObjectPtr<> left_object(parse_object());
-  ObjectPtr<ConsObject> list_item(new ConsObject(left_object));
-  Token current_token = tokenizer_->peek_token();
+  ConsObject* list_item = new ConsObject(*object);
+  if (frame->tail != nullptr) {
+    frame->tail->set_right_value(list_item);
+  } else {
+    frame->head = list_item;
+  }
+  frame->tail = list_item;
 
-  if (current_token.type == TokenType::kDot) {
+  const TokenType next_type = tokenizer_->peek_token().type;
+  if (next_type == TokenType::kDot) {
     tokenizer_->next_token();
-    list_item->set_right_value(parse_object());
-    expect_token(Token(TokenType::kCloseBracket), true);
-  } else if (current_token.type == TokenType::kEnd) {
+    frame->type = Frame::Type::kListTail;
+  } else if (next_type == TokenType::kEnd) {
     throw ParserError("Unexpected end of file");
-  } else {
-    list_item->set_right_value(parse_begun_list());
   }
 
-  return list_item;
+  return false;
 }
 
 void Parser::expect_token(const Token& tok, bool extract) {
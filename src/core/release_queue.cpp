@@ -0,0 +1,90 @@
+#include <lispp/release_queue.h>
+
+#include <vector>
+
+#include <lispp/object.h>
+
+namespace lispp {
+
+namespace {
+
+  thread_local bool local_queue_destroyed = false;
+
+  struct LocalQueue {
+    ~LocalQueue() {
+      draining = true;
+      while (!pending.empty()) {
+        Object* object = pending.back();
+        pending.pop_back();
+        delete object;
+      }
+      local_queue_destroyed = true;
+    }
+
+    // NOTE: used as a stack: members of the last deleted object go first,
+    //       so the pending size is bounded by the width of the structure
+    std::vector<Object*> pending;
+    std::size_t budget = ReleaseQueue::kUnlimitedBudget;
+    bool draining = false;
+  };
+
+  thread_local LocalQueue local_queue;
+
+  std::size_t drain_pending(LocalQueue& queue, std::size_t budget,
+                            std::size_t deleted_count) {
+    queue.draining = true;
+    while (!queue.pending.empty() &&
+           (budget == ReleaseQueue::kUnlimitedBudget ||
+            deleted_count < budget)) {
+      Object* object = queue.pending.back();
+      queue.pending.pop_back();
+      delete object;
+      ++deleted_count;
+    }
+    queue.draining = false;
+
+    return deleted_count;
+  }
+
+} // namespace
+
+void ReleaseQueue::release(Object* object) {
+  if (local_queue_destroyed) {
+    delete object;
+    return;
+  }
+
+  LocalQueue& queue = local_queue;
+  if (queue.draining) {
+    queue.pending.push_back(object);
+    return;
+  }
+
+  queue.draining = true;
+  delete object;
+  drain_pending(queue, queue.budget, 1);
+}
+
+std::size_t ReleaseQueue::drain(std::size_t budget) {
+  if (local_queue_destroyed || local_queue.draining) {
+    return 0;
+  }
+
+  return drain_pending(local_queue, budget, 0);
+}
+
+std::size_t ReleaseQueue::get_pending_count() {
+  return (local_queue_destroyed ? 0 : local_queue.pending.size());
+}
+
+std::size_t ReleaseQueue::get_budget() {
+  return (local_queue_destroyed ? kUnlimitedBudget : local_queue.budget);
+}
+
+void ReleaseQueue::set_budget(std::size_t budget) {
+  if (!local_queue_destroyed) {
+    local_queue.budget = budget;
+  }
+}
+
+} // lispp
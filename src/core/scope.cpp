@@ -1,53 +1,317 @@
 #include <lispp/scope.h>
 
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <set>
+
 #include <lispp/builtins.h>
 
 namespace lispp {
 
-Scope::Scope(const std::shared_ptr<Scope>& parent_scope)
-    : parent_scope_(parent_scope) {}
+namespace {
 
-bool Scope::has_value(const std::string& name) const {
-  return (scope_.count(name) > 0) ||
+  struct SlotNamesStorage {
+    std::mutex mutex;
+    std::set<SlotNames> names;
+  };
+
+  SlotNamesStorage& get_slot_names_storage() {
+    static SlotNamesStorage storage;
+    return storage;
+  }
+
+  // NOTE: never freed (see intern_slot_names)
+  void delete_nothing(const SlotNames*) {}
+
+  // NOTE: the low bits of versions count the versions made by the thread
+  constexpr int kVersionCounterBits = 40;
+
+} // namespace
+
+std::shared_ptr<const SlotNames> intern_slot_names(const SlotNames& names) {
+  auto& storage = get_slot_names_storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+
+  // NOTE: std::set doesn't move elements
+  const SlotNames& interned = *storage.names.insert(names).first;
+  return std::shared_ptr<const SlotNames>(&interned, delete_nothing);
+}
+
+Scope::Scope() : slots_count_(0), versioned_(0), frozen_(0) {
+  init_version();
+}
+
+Scope::Scope(const ScopePtr& parent_scope)
+    : slots_count_(0), versioned_(0), frozen_(0),
+    parent_scope_(parent_scope) {
+  init_version();
+}
+
+Scope::Scope(const ScopePtr& parent_scope, const SlotNames* slot_names)
+    : slots_count_(static_cast<std::uint32_t>(slot_names->size())),
+    versioned_(0), frozen_(0), parent_scope_(parent_scope),
+    slot_names_(slot_names) {
+  init_version();
+  ObjectPtr<>* slots = get_slots();
+  for (std::size_t slot = 0; slot < slots_count_; ++slot) {
+    new (slots + slot) ObjectPtr<>();
+  }
+}
+
+Scope::~Scope() {
+  bump_version();
+  // NOTE: scopes may be released by thread-local destructors on exit
+  if (collector_link_.prev != nullptr && !CycleCollector::is_destroyed()) {
+    CycleCollector::get_current().untrack(this);
+  }
+
+  ObjectPtr<>* slots = get_slots();
+  for (std::size_t slot = 0; slot < slots_count_; ++slot) {
+    slots[slot].~ObjectPtr();
+  }
+}
+
+ScopePtr Scope::create_frame(const ScopePtr& parent_scope,
+                             const SlotNames* slot_names) {
+  void* memory = ObjectPool::allocate(
+      sizeof(Scope) + slot_names->size() * sizeof(ObjectPtr<>));
+  return ScopePtr(::new (memory) Scope(parent_scope, slot_names));
+}
+
+// NOTE: children of frozen scopes are roots: frozen scopes are shared by
+//       threads and never change anyway
+void Scope::init_version() {
+  if (parent_scope_ && !parent_scope_->frozen_) {
+    version_root_ = parent_scope_->version_root_;
+  } else {
+    version_ = make_version();
+  }
+}
+
+// NOTE: each thread makes versions of its own range, so they are unique
+//       without synchronization
+std::uint64_t Scope::make_version() {
+  static std::atomic<std::uint64_t> next_thread_index(1);
+  thread_local const std::uint64_t thread_bits =
+      next_thread_index.fetch_add(1, std::memory_order_relaxed)
+      << kVersionCounterBits;
+  thread_local std::uint64_t versions_count = 0;
+
+  return thread_bits | ++versions_count;
+}
+
+void Scope::destroy() {
+  Scope* scope = this;
+  while (scope != nullptr) {
+    // NOTE: the parent is deleted in this loop if it's the last reference
+    Scope* parent_scope = scope->parent_scope_.release();
+    const std::size_t allocation_size = scope->get_allocation_size();
+    scope->~Scope();
+    ObjectPool::deallocate(scope, allocation_size);
+
+    scope = (parent_scope != nullptr && parent_scope->ref_count_ == 0
+             ? parent_scope : nullptr);
+  }
+}
+
+void Scope::freeze() {
+  assert(!parent_scope_ && slots_count_ == 0);
+  if (frozen_) {
+    return;
+  }
+
+  // NOTE: immortal values are skipped by the collector as frozen scopes are
+  CycleCollector::get_current().untrack(this);
+  if (scope_) {
+    for (auto& value : *scope_) {
+      if (value.second.valid()) {
+        value.second->make_immortal();
+      }
+    }
+  }
+  frozen_ = 1;
+}
+
+void Scope::check_not_frozen(SymbolId name) const {
+  if (frozen_) {
+    throw ScopeError("Cannot change '" + SymbolTable::get_name(name) +
+                     "' in frozen scope");
+  }
+}
+
+bool Scope::has_value(SymbolId name) const {
+  return (find_slot(name) >= 0) || (scope_ && scope_->count(name) > 0) ||
          (parent_scope_ && parent_scope_->has_value(name));
 }
 
-ObjectPtr<> Scope::get_value(const std::string& name) {
-  auto object_it = scope_.find(name);
-  if (object_it != scope_.end()) {
-    return object_it->second;
-  } else if (parent_scope_) {
+bool Scope::has_value(const std::string& name) const {
+  return has_value(SymbolTable::intern(name));
+}
+
+ObjectPtr<> Scope::get_value(SymbolId name) {
+  const int slot = find_slot(name);
+  if (slot >= 0) {
+    return get_slots()[slot];
+  }
+
+  if (scope_) {
+    auto object_it = scope_->find(name);
+    if (object_it != scope_->end()) {
+      return object_it->second;
+    }
+  }
+
+  if (parent_scope_) {
     return parent_scope_->get_value(name);
   } else {
-    throw ScopeError("Cannot get '" + name + "'");
+    throw ScopeError("Cannot get '" + SymbolTable::get_name(name) + "'");
+  }
+}
+
+ObjectPtr<> Scope::get_value(const std::string& name) {
+  return get_value(SymbolTable::intern(name));
+}
+
+void Scope::set_value(SymbolId name, const ObjectPtr<>& object) {
+  const int slot = find_slot(name);
+  if (slot >= 0) {
+    get_slots()[slot] = object;
+    return;
   }
+
+  check_not_frozen(name);
+  if (!scope_) {
+    scope_.reset(new Values);
+  }
+  (*scope_)[name] = object;
+  bump_version();
 }
 
 void Scope::set_value(const std::string& name, const ObjectPtr<>& object) {
-  scope_[name] = object;
+  set_value(SymbolTable::intern(name), object);
 }
 
-void Scope::replace_value(const std::string& name, const ObjectPtr<>& object) {
-  auto iter = scope_.find(name);
-  if (iter != scope_.end()) {
-    iter->second = object;
+void Scope::replace_value(SymbolId name, const ObjectPtr<>& object) {
+  const int slot = find_slot(name);
+  if (slot >= 0) {
+    get_slots()[slot] = object;
+    return;
+  }
+
+  if (scope_) {
+    auto iter = scope_->find(name);
+    if (iter != scope_->end()) {
+      check_not_frozen(name);
+      iter->second = object;
+      bump_version();
+      return;
+    }
+  }
+
+  if (has_parent_scope() && parent_scope_->frozen_ &&
+      parent_scope_->has_value(name)) {
+    set_value(name, object);
   } else if (has_parent_scope()) {
     parent_scope_->replace_value(name, object);
   } else {
-    throw ScopeError("No variable named " + name);
+    throw ScopeError("No variable named " + SymbolTable::get_name(name));
   }
 }
 
+void Scope::replace_value(const std::string& name,
+                          const ObjectPtr<>& object) {
+  replace_value(SymbolTable::intern(name), object);
+}
+
+bool Scope::get_versioned_value(SymbolId name, Object** value) {
+  Scope* scope = this;
+  while (scope != nullptr) {
+    if (scope->find_slot(name) >= 0) {
+      return false;
+    }
+
+    // NOTE: frozen scopes never change
+    if (!scope->frozen_) {
+      scope->versioned_ = 1;
+    }
+    if (scope->scope_) {
+      auto object_it = scope->scope_->find(name);
+      if (object_it != scope->scope_->end()) {
+        *value = object_it->second.get();
+        return true;
+      }
+    }
+    scope = scope->parent_scope_.get();
+  }
+
+  throw ScopeError("Cannot get '" + SymbolTable::get_name(name) + "'");
+}
+
+bool Scope::make_versioned() {
+  for (Scope* scope = this; scope != nullptr;
+       scope = scope->parent_scope_.get()) {
+    // NOTE: frozen scopes never change
+    if (scope->frozen_) {
+      continue;
+    } else if (scope->slots_count_ > 0) {
+      return false;
+    }
+    scope->versioned_ = 1;
+  }
+  return true;
+}
+
 bool Scope::has_parent_scope() const {
   return bool(parent_scope_);
 }
 
-std::shared_ptr<Scope> Scope::get_parent_scope() {
+ScopePtr Scope::get_parent_scope() {
   return parent_scope_;
 }
 
-std::shared_ptr<Scope> Scope::create_child_scope() {
-  return std::make_shared<Scope>(shared_from_this());
+ScopePtr Scope::create_child_scope() {
+  return ScopePtr(new Scope(ScopePtr(this)));
+}
+
+void Scope::traverse(ReferenceVisitor& visitor) const {
+  if (scope_) {
+    for (const auto& value : *scope_) {
+      visitor.visit(value.second);
+    }
+  }
+  const ObjectPtr<>* slots = get_slots();
+  for (std::size_t slot = 0; slot < slots_count_; ++slot) {
+    visitor.visit(slots[slot]);
+  }
+  visitor.visit(parent_scope_);
+}
+
+void Scope::clear() {
+  bump_version();
+  // NOTE: the root may be cleared and freed before this scope
+  version_root_ = this;
+  scope_.reset();
+  ObjectPtr<>* slots = get_slots();
+  for (std::size_t slot = 0; slot < slots_count_; ++slot) {
+    slots[slot].reset();
+  }
+  parent_scope_.reset();
+}
+
+int Scope::find_slot(SymbolId name) const {
+  if (slot_names_ == nullptr) {
+    return -1;
+  }
+
+  // NOTE: the last one wins for duplicated names (as in let)
+  for (std::size_t slot = slot_names_->size(); slot > 0; --slot) {
+    if ((*slot_names_)[slot - 1] == name) {
+      return static_cast<int>(slot - 1);
+    }
+  }
+
+  return -1;
 }
 
 } // lispp
@@ -0,0 +1,65 @@
+#include <lispp/stdlib_image.h>
+
+#include <cassert>
+
+#include <lispp/objects_all.h>
+
+namespace lispp {
+
+namespace {
+
+  ObjectPtr<> pop(std::vector<ObjectPtr<>>* stack) {
+    assert(!stack->empty());
+    auto result = std::move(stack->back());
+    stack->pop_back();
+    return result;
+  }
+
+  ObjectPtr<> make_node(const ImageNode& node,
+                        std::vector<ObjectPtr<>>* stack) {
+    switch (node.type) {
+      case ImageNodeType::kNil:
+        return nullptr;
+      case ImageNodeType::kTrue:
+        return BooleanObject::make(true);
+      case ImageNodeType::kFalse:
+        return BooleanObject::make(false);
+      case ImageNodeType::kNumber:
+        return NumberObject::make(node.number_value);
+      case ImageNodeType::kCharacters:
+        return new CharactersObject(node.string_value);
+      case ImageNodeType::kSymbol:
+        return SymbolObject::intern(node.string_value);
+      case ImageNodeType::kCons: {
+        auto right_value = pop(stack);
+        auto left_value = pop(stack);
+        return new ConsObject(left_value, right_value);
+      }
+      case ImageNodeType::kQuote:
+        return new QuoteObject(pop(stack));
+      case ImageNodeType::kComma:
+        return new CommaObject(pop(stack));
+      case ImageNodeType::kBackTick:
+        return new BackTickObject(pop(stack));
+    }
+
+    assert(false && "Unknown image node");
+    return nullptr;
+  }
+
+} // namespace
+
+std::vector<ObjectPtr<>> load_stdlib_image(const StdlibImage& image) {
+  std::vector<ObjectPtr<>> stack;
+  for (std::size_t index = 0; index < image.nodes_count; ++index) {
+    auto object = make_node(image.nodes[index], &stack);
+    if (object.valid()) {
+      object->make_immortal();
+    }
+    stack.push_back(std::move(object));
+  }
+
+  return stack;
+}
+
+} // lispp
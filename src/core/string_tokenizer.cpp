@@ -2,31 +2,26 @@
 
 namespace lispp {
 
-StringTokenizer::StringTokenizer() {
-  set_input_stream(input_ss_);
-}
+StringTokenizer::StringTokenizer() {}
 
 StringTokenizer::StringTokenizer(const std::string& initial_value) {
-  set_input_stream(input_ss_);
   append(initial_value);
 }
 
 void StringTokenizer::clear() {
-  input_ss_.clear();
-  next_token(); // NOTE: eat cached token
-  next_token();
+  BufferTokenizer::clear();
+  buffer_.clear();
+  set_buffer(buffer_.data(), buffer_.size());
 }
 
 void StringTokenizer::append(const std::string& value) {
-  /* NOTE: we should clear the stringstream to clear flags.
-   *       This shouldn't break the underlying tokenizer
-   *       if stream is already ended
-   */
-  if (!input_ss_.good()) {
-    input_ss_.clear();
-  }
-
-  input_ss_<< value;
+  // NOTE: the scanned text is dropped, so the buffer doesn't grow
+  //       with every appended piece of code
+  const std::size_t consumed_count = get_consumed_count();
+  const std::size_t position = get_position();
+  buffer_.erase(0, consumed_count);
+  buffer_ += value;
+  set_buffer(buffer_.data(), buffer_.size(), position - consumed_count);
 }
 
 } // lispp
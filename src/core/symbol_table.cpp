@@ -0,0 +1,108 @@
+#include <lispp/symbol_table.h>
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include <lispp/symbol_object.h>
+
+namespace lispp {
+
+namespace {
+
+  // NOTE: name of a symbol or text of a token, so the text isn't copied
+  //       to be looked up
+  struct NameView {
+    const char* data;
+    std::size_t size;
+
+    bool operator==(const NameView& other) const {
+      return size == other.size && std::memcmp(data, other.data, size) == 0;
+    }
+  };
+
+  // NOTE: FNV-1a
+  struct NameViewHash {
+    std::size_t operator()(const NameView& name) const {
+      std::uint64_t hash = 14695981039346656037ull;
+      for (std::size_t index = 0; index < name.size; ++index) {
+        hash ^= static_cast<unsigned char>(name.data[index]);
+        hash *= 1099511628211ull;
+      }
+      return static_cast<std::size_t>(hash);
+    }
+  };
+
+  // NOTE: keys are views of the names of the symbols
+  using SymbolsByName =
+      std::unordered_map<NameView, SymbolObject*, NameViewHash>;
+
+  struct SymbolTableStorage {
+    std::mutex mutex;
+    SymbolsByName symbols_by_name;
+    // NOTE: deque doesn't move elements so returned names stay valid
+    std::deque<ObjectPtr<SymbolObject>> symbols;
+  };
+
+  SymbolTableStorage& get_storage() {
+    static SymbolTableStorage storage;
+    return storage;
+  }
+
+} // namespace
+
+SymbolId SymbolTable::intern(const std::string& name) {
+  return intern_symbol(name.data(), name.size())->get_id();
+}
+
+ObjectPtr<SymbolObject> SymbolTable::intern_symbol(const char* name,
+                                                   std::size_t size) {
+  // NOTE: Symbols are never released, so each thread caches the ones it
+  //       has interned: the names known to the thread are looked up
+  //       without the lock (e.g. by the workers of ParallelParser)
+  thread_local SymbolsByName local_symbols_by_name;
+
+  auto symbol_it = local_symbols_by_name.find(NameView{name, size});
+  if (symbol_it != local_symbols_by_name.end()) {
+    return symbol_it->second;
+  }
+
+  SymbolObject* symbol = intern_shared_symbol(name, size);
+  const std::string& value = symbol->get_value();
+  local_symbols_by_name.emplace(NameView{value.data(), value.size()}, symbol);
+  return symbol;
+}
+
+const std::string& SymbolTable::get_name(SymbolId id) {
+  return get_symbol(id)->get_value();
+}
+
+ObjectPtr<SymbolObject> SymbolTable::get_symbol(SymbolId id) {
+  auto& storage = get_storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+  return storage.symbols.at(id);
+}
+
+SymbolObject* SymbolTable::intern_shared_symbol(const char* name,
+                                                std::size_t size) {
+  auto& storage = get_storage();
+  std::lock_guard<std::mutex> lock(storage.mutex);
+
+  auto symbol_it = storage.symbols_by_name.find(NameView{name, size});
+  if (symbol_it != storage.symbols_by_name.end()) {
+    return symbol_it->second;
+  }
+
+  const SymbolId id = storage.symbols.size();
+  auto* symbol = new SymbolObject(std::string(name, size), id);
+  symbol->make_immortal();
+  storage.symbols.emplace_back(symbol);
+  const std::string& value = symbol->get_value();
+  storage.symbols_by_name.emplace(NameView{value.data(), value.size()},
+                                  symbol);
+  return symbol;
+}
+
+} // lispp
@@ -4,18 +4,10 @@
 
 namespace lispp {
 
-Token::Token(TokenType type) : type(type) {}
-
-Token::Token(TokenType type, double number_value)
-    : type(type), number_value(number_value) {}
-
-Token::Token(TokenType type, const std::string& string_value)
-    : type(type), string_value(string_value) {}
-
-
 bool Token::operator==(const Token& other) const {
   return (type == other.type) && (number_value == other.number_value) &&
-         (string_value == other.string_value);
+         (text_size == other.text_size) &&
+         (std::char_traits<char>::compare(text, other.text, text_size) == 0);
 }
 
 bool Token::operator!=(const Token& other) const {
@@ -48,9 +40,11 @@ std::ostream& operator<<(std::ostream& out, const Token& token) {
   if (token.type == TokenType::kNumber) {
     out << " " << token.number_value;
   } else if (token.type == TokenType::kCharacters) {
-    out << " \"" << token.string_value << "\"";
+    out << " \"";
+    out.write(token.text, token.text_size) << "\"";
   } else if (token.type == TokenType::kSymbol) {
-    out << " " << token.string_value;
+    out << " ";
+    out.write(token.text, token.text_size);
   }
   out << ")";
 
@@ -2,22 +2,118 @@
 
 #include <sstream>
 
+#include <lispp/cycle_collector.h>
 #include <lispp/list_utils.h>
 
 namespace lispp {
 
+constexpr std::size_t UserCallableObject::kMaxExpansionsCount;
+
 UserCallableObject::UserCallableObject(
-    const std::string& name, const std::vector<std::string>& args,
-    const std::vector<ObjectPtr<>>& body, const std::shared_ptr<Scope>& closure,
+    const std::string& name, const std::vector<SymbolId>& args,
+    const std::vector<ObjectPtr<>>& body, const ScopePtr& closure,
     const std::string& rest_arg_name, CallableType type)
-    : CallableObject(type, true), name_(name), args_(args), body_(body),
-    closure_(closure), rest_arg_name_(rest_arg_name) {}
+    // NOTE: caller's scope is used only to eval macro expansions
+    : CallableObject(type, type == CallableType::kMacro),
+    name_(name), args_(args), body_(body),
+    closure_(closure), has_rest_arg_(!rest_arg_name.empty()),
+    rest_arg_name_(has_rest_arg_ ? SymbolTable::intern(rest_arg_name) : 0) {
+  CycleCollector::get_current().track(closure_.get());
+}
+
+ObjectPtr<> UserCallableObject::execute(const ScopePtr& scope,
+                                        const ObjectPtr<>& args) {
+  if (!is_memoized_macro()) {
+    return CallableObject::execute(scope, args);
+  }
+
+  return run_trampoline(execute_tail(scope, args));
+}
+
+TailResult UserCallableObject::execute_tail(const ScopePtr& scope,
+                                            const ObjectPtr<>& args) {
+  if (!is_memoized_macro()) {
+    return CallableObject::execute_tail(scope, args);
+  }
+
+  // NOTE: evaluated in the separate scope as execute_tail_impl does
+  auto expansion = expand(args);
+  return TailResult(expansion, scope->create_child_scope());
+}
+
+void UserCallableObject::traverse(ReferenceVisitor& visitor) const {
+  for (const auto& expression : body_) {
+    visitor.visit(expression);
+  }
+  visitor.visit(closure_);
+  for (const auto& expansion : expansions_) {
+    visitor.visit(expansion.second.args);
+    visitor.visit(expansion.second.expansion);
+  }
+}
 
-ObjectPtr<> UserCallableObject::execute_impl(
-    const std::shared_ptr<Scope>& scope,
-    const std::vector<ObjectPtr<>>& args) {
+void UserCallableObject::clear_references() {
+  body_.clear();
+  closure_.reset();
+  expansions_.clear();
+}
+
+ObjectPtr<> UserCallableObject::execute_impl(const ScopePtr& scope,
+                                             ArgsSpan args) {
+  return run_trampoline(execute_tail_impl(scope, args));
+}
+
+TailResult UserCallableObject::execute_tail_impl(const ScopePtr& scope,
+                                                ArgsSpan args) {
+  ScopePtr local_scope = bind_args(args);
+
+  if (body_.empty()) {
+    return TailResult();
+  }
+
+  for (auto it = body_.begin(); std::next(it) != body_.end(); ++it) {
+    ObjectPtr<> result = it->safe_eval(local_scope);
+    // NOTE: this scope? It's strange place but macroses are evaluated twice?
+    if (get_type() == CallableType::kMacro) {
+      result.safe_eval(scope);
+    }
+  }
+
+  if (get_type() == CallableType::kMacro) {
+    return TailResult(body_.back().safe_eval(local_scope), scope);
+  } else {
+    return TailResult(body_.back(), local_scope);
+  }
+}
+
+ObjectPtr<> UserCallableObject::expand(const ObjectPtr<>& args) {
+  auto expansion_it = expansions_.find(args.get());
+  if (expansion_it != expansions_.end() &&
+      expansion_it->second.version == closure_->get_version()) {
+    return expansion_it->second.expansion;
+  }
+
+  auto unpacked_args = unpack_list(args);
+  auto expansion = body_.back().safe_eval(bind_args(unpacked_args));
+
+  // NOTE: the version is taken after the body changed what it changes
+  if (!closure_->make_versioned()) {
+    return expansion;
+  }
+
+  // NOTE: forms built at runtime (e.g. by eval) are never reused
+  if (expansions_.size() >= kMaxExpansionsCount) {
+    expansions_.clear();
+  }
+  expansions_[args.get()] =
+      Expansion{args, expansion, closure_->get_version()};
+
+  return expansion;
+}
+
+ScopePtr UserCallableObject::bind_args(ArgsSpan args) const {
   if (args.size() < args_.size() ||
-      (rest_arg_name_.empty() && args.size() > args_.size())) {
+      (!has_rest_arg_ && args.size() > args_.size())) {
     std::stringstream ss;
     ss << name_ << " "
        << (get_type() == CallableType::kFunction ? "function" : "macro")
@@ -25,28 +121,17 @@ ObjectPtr<> UserCallableObject::execute_impl(
     throw ExecutionError(ss.str());
   }
 
-  std::shared_ptr<Scope> local_scope = closure_->create_child_scope();
+  ScopePtr local_scope = closure_->create_child_scope();
   for (std::size_t arg_index = 0; arg_index < args_.size(); ++arg_index) {
     local_scope->set_value(args_[arg_index], args[arg_index]);
   }
 
-  if (!rest_arg_name_.empty()) {
-    std::vector<ObjectPtr<>> rest_args(
-        std::next(args.begin(), args_.size()), args.end());
-    auto rest_lst = pack_list(rest_args);
-    local_scope->set_value(rest_arg_name_, rest_lst);
-  }
-
-  ObjectPtr<> result;
-  for (auto body_expression : body_) {
-    result = body_expression.safe_eval(local_scope);
-    // NOTE: this scope? It's strange place but macroses are evaluated twice?
-    if (get_type() == CallableType::kMacro) {
-      result = result.safe_eval(scope);
-    }
+  if (has_rest_arg_) {
+    local_scope->set_value(rest_arg_name_,
+                           pack_list(args.subspan(args_.size())));
   }
 
-  return result;
+  return local_scope;
 }
 
 } // lispp
@@ -1,6 +1,9 @@
 #include <lispp/virtual_machine_base.h>
 
 #include <lispp/builtins.h>
+#include <lispp/compiler.h>
+#include <lispp/cycle_collector.h>
+#include <lispp/interpreter.h>
 
 namespace lispp {
 
@@ -14,8 +17,16 @@ ObjectPtr<> VirtualMachineBase::parse() {
 }
 
 ObjectPtr<> VirtualMachineBase::eval() {
-  auto object = parse();
-  return object.safe_eval(global_scope_);
+  // NOTE: top level is a safe point: no raw pointers to objects are held
+  CycleCollector::get_current().maybe_collect();
+
+  return run(parse());
+}
+
+ObjectPtr<> VirtualMachineBase::eval_form(const ObjectPtr<>& form) {
+  CycleCollector::get_current().maybe_collect();
+
+  return run(form);
 }
 
 ObjectPtr<> VirtualMachineBase::eval_all() {
@@ -30,12 +41,17 @@ ObjectPtr<> VirtualMachineBase::eval_all() {
 Parser& VirtualMachineBase::get_parser() {
   return *parser_;
 }
-std::shared_ptr<Scope> VirtualMachineBase::get_global_scope() {
+ScopePtr VirtualMachineBase::get_global_scope() {
   return global_scope_;
 }
 
+bool VirtualMachineBase::set_process_object_allocator(
+    ObjectAllocatorType type) {
+  return ObjectPool::set_allocator_type(type);
+}
+
 VirtualMachineBase::VirtualMachineBase(
-    const std::shared_ptr<Scope>& global_scope, ITokenizer* tokenizer) {
+    const ScopePtr& global_scope, ITokenizer* tokenizer) {
   init(tokenizer);
 
   global_scope_ = global_scope;
@@ -44,8 +60,7 @@ VirtualMachineBase::VirtualMachineBase(
 VirtualMachineBase::VirtualMachineBase(ITokenizer* tokenizer) {
   init(tokenizer);
 
-  global_scope_.reset(new Scope);
-  init_global_scope(global_scope_);
+  global_scope_ = get_base_scope()->create_child_scope();
 }
 
 void VirtualMachineBase::init(ITokenizer* tokenizer) {
@@ -57,4 +72,11 @@ ITokenizer* VirtualMachineBase::get_tokenizer_base() {
   return tokenizer_;
 }
 
+ObjectPtr<> VirtualMachineBase::run(const ObjectPtr<>& form) {
+  auto code = Compiler(global_scope_).compile(form);
+
+  Interpreter interpreter;
+  return interpreter.run(code, global_scope_);
+}
+
 } // lispp
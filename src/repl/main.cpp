@@ -1,10 +1,15 @@
+#include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include <lispp/batch_runner.h>
 #include <lispp/object.h>
 #include <lispp/object_ptr.h>
 #include <lispp/istream_tokenizer.h>
 #include <lispp/file_tokenizer.h>
+#include <lispp/parallel_parser.h>
 #include <lispp/parser.h>
 #include <lispp/scope.h>
 #include <lispp/virtual_machine.h>
@@ -83,18 +88,37 @@ void RunAsRepl() {
 }
 #endif
 
-void RunFromFile(const std::string filename) {
-  lispp::VirtualMachine<lispp::FileTokenizer> vm(filename);
+// NOTE: forms are parsed on the parse pool if it's set (see ParallelParser)
+void RunFromFile(const std::string filename,
+                 lispp::IsolatePool* parse_pool = nullptr) {
+  std::unique_ptr<lispp::VirtualMachine<lispp::FileTokenizer>> file_vm;
+  try {
+    file_vm.reset(new lispp::VirtualMachine<lispp::FileTokenizer>(filename));
+  } catch (const lispp::TokenizerError& e) {
+    std::cout << "TokenizerError: " << e.what() << std::endl;
+    return;
+  }
+  auto& vm = *file_vm;
+  std::unique_ptr<lispp::ParallelParser> parallel_parser;
+  auto get_current_line = [&]() {
+    return (parallel_parser ? parallel_parser->get_current_line()
+                            : vm.get_tokenizer().get_current_line());
+  };
 
   try {
-    vm.eval_all();
+    if (parse_pool != nullptr) {
+      parallel_parser.reset(new lispp::ParallelParser(parse_pool));
+      parallel_parser->parse_all(
+          vm.get_tokenizer().get_data(), vm.get_tokenizer().get_size(),
+          [&vm](const lispp::ObjectPtr<>& form) { vm.eval_form(form); });
+    } else {
+      vm.eval_all();
+    }
   } catch (const lispp::TokenizerError& e) {
-    std::cout << "TokenizerError at line "
-              << vm.get_tokenizer().get_current_line() << ": "
+    std::cout << "TokenizerError at line " << get_current_line() << ": "
               << e.what() << std::endl;
   } catch (const lispp::ParserError& e) {
-    std::cout << "ParserError at line "
-              << vm.get_tokenizer().get_current_line() << ": "
+    std::cout << "ParserError at line " << get_current_line() << ": "
               << e.what() << std::endl;
   } catch (const lispp::ExecutionError& e) {
     std::cout << "ExecutionError: " << e.what() << std::endl;
@@ -107,9 +131,81 @@ void RunFromFile(const std::string filename) {
   }
 }
 
+// NOTE: lispp --batch [-j threads] [file...]
+//       Evaluates the files (or every line of stdin as a separate script if
+//       there are no files) in parallel, each in its own VM. Outputs are
+//       printed in the input order, values are printed for stdin records
+int RunBatch(int argc, const char* argv[]) {
+  std::size_t threads_count = 0;
+  std::vector<lispp::BatchInput> inputs;
+  for (int arg_index = 0; arg_index < argc; ++arg_index) {
+    const std::string arg = argv[arg_index];
+    if (arg == "-j" && arg_index + 1 < argc) {
+      threads_count = std::strtoul(argv[++arg_index], nullptr, 10);
+    } else {
+      inputs.push_back(lispp::BatchInput{arg, arg, ""});
+    }
+  }
+
+  const bool records = inputs.empty();
+  if (records) {
+    std::string line;
+    for (int line_number = 1; std::getline(std::cin, line); ++line_number) {
+      if (!line.empty()) {
+        inputs.push_back(lispp::BatchInput{
+            "record " + std::to_string(line_number), "", line});
+      }
+    }
+  }
+
+  lispp::IsolatePool pool(threads_count);
+  const std::size_t failed_count = lispp::run_batch(
+      pool, inputs, [records](const lispp::BatchResult& result) {
+        std::cout << result.output;
+        if (!result.succeeded) {
+          std::cout << result.name << ": " << result.error << std::endl;
+        } else if (records) {
+          std::cout << result.value << std::endl;
+        }
+      });
+
+  std::cerr << inputs.size() << " inputs, " << failed_count << " failed"
+            << std::endl;
+  return (failed_count == 0 ? 0 : 1);
+}
+
+// NOTE: lispp --parallel-parse [-j threads] file
+//       Parses the forms of a large file on threads and evaluates them in
+//       order, as they are parsed
+int RunParallelParsed(int argc, const char* argv[]) {
+  std::size_t threads_count = 0;
+  std::string filename;
+  for (int arg_index = 0; arg_index < argc; ++arg_index) {
+    const std::string arg = argv[arg_index];
+    if (arg == "-j" && arg_index + 1 < argc) {
+      threads_count = std::strtoul(argv[++arg_index], nullptr, 10);
+    } else {
+      filename = arg;
+    }
+  }
+
+  if (filename.empty()) {
+    std::cerr << "No file to parse" << std::endl;
+    return 1;
+  }
+
+  lispp::IsolatePool pool(threads_count);
+  RunFromFile(filename, &pool);
+  return 0;
+}
+
 int main(int argc, const char* argv[]) {
   if (argc == 1) {
     RunAsRepl();
+  } else if (std::string(argv[1]) == "--batch") {
+    return RunBatch(argc - 2, argv + 2);
+  } else if (std::string(argv[1]) == "--parallel-parse") {
+    return RunParallelParsed(argc - 2, argv + 2);
   } else {
     RunFromFile(argv[1]);
   }
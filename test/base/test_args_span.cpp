@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <lispp/args_span.h>
+#include <lispp/number_object.h>
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+TEST(ArgsSpanTest, Vector) {
+  std::vector<ObjectPtr<>> args{NumberObject::make(1), NumberObject::make(2),
+                                NumberObject::make(3)};
+  ArgsSpan span(args);
+  ASSERT_EQ(3u, span.size());
+  EXPECT_EQ(args[0], span.front());
+  EXPECT_EQ(args[2], span.back());
+
+  ArgsSpan tail = span.subspan(1);
+  ASSERT_EQ(2u, tail.size());
+  EXPECT_EQ(args[1], tail[0]);
+  EXPECT_TRUE(span.subspan(3).empty());
+}
+
+TEST(ArgsBufferTest, Spill) {
+  ArgsBuffer buffer;
+  for (int index = 0; index < 20; ++index) {
+    buffer.push_back(NumberObject::make(index));
+  }
+
+  ArgsSpan span = buffer.get_span();
+  ASSERT_EQ(20u, span.size());
+  for (int index = 0; index < 20; ++index) {
+    EXPECT_EQ(NumberObject::make(index).get(), span[index].get());
+  }
+}
+
+// NOTE: evaluates forms by tree-walking eval (without bytecode compiler)
+class CallArgsTest : public ::testing::Test {
+protected:
+  std::string eval(const std::string& code) {
+    auto result = vm.parse(code).safe_eval(vm.get_global_scope());
+    return (result.valid() ? result->to_string() : "()");
+  }
+
+  VirtualMachine<> vm;
+};
+
+TEST_F(CallArgsTest, ManyArgs) {
+  EXPECT_EQ("55", eval("(+ 1 2 3 4 5 6 7 8 9 10)"));
+  eval("(define (f a b c d e f g h i j) (list a j))");
+  EXPECT_EQ("(1 10)", eval("(f 1 2 3 4 5 6 7 8 9 10)"));
+}
+
+TEST_F(CallArgsTest, RestArgs) {
+  eval("(define (f a . rest) rest)");
+  EXPECT_EQ("(2 3 4 5 6 7 8 9 10)", eval("(f 1 2 3 4 5 6 7 8 9 10)"));
+  EXPECT_EQ("()", eval("(f 1)"));
+}
+
+TEST_F(CallArgsTest, ImproperArgsList) {
+  EXPECT_THROW(eval("(+ 1 . 2)"), ExecutionError);
+}
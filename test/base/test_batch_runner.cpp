@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <lispp/batch_runner.h>
+
+using namespace lispp;
+
+TEST(BatchRunnerTest, InputOrder) {
+  std::vector<BatchInput> inputs;
+  for (int index = 0; index < 100; ++index) {
+    const std::string number = std::to_string(index);
+    inputs.push_back(BatchInput{
+        number, "", "(print " + number + ") (length (make-list " +
+                    std::to_string((100 - index) * 100) + " 0))"});
+  }
+
+  IsolatePool pool(4);
+  std::vector<BatchResult> results;
+  EXPECT_EQ(0u, run_batch(pool, inputs, [&results](const BatchResult& result) {
+    results.push_back(result);
+  }));
+
+  ASSERT_EQ(inputs.size(), results.size());
+  for (int index = 0; index < 100; ++index) {
+    EXPECT_EQ(std::to_string(index), results[index].name);
+    EXPECT_TRUE(results[index].succeeded);
+    EXPECT_EQ(std::to_string(index) + "\n", results[index].output);
+    EXPECT_EQ(std::to_string((100 - index) * 100), results[index].value);
+  }
+}
+
+TEST(BatchRunnerTest, Errors) {
+  const std::vector<BatchInput> inputs{
+    {"runtime", "", "(print 1) (car 1) (print 2)"},
+    {"name", "", "undefined-name"},
+    {"syntax", "", "(+ 1"},
+    {"ok", "", "(define x 1) x"},
+    {"missing", "/nonexistent/file.lisp", ""}
+  };
+
+  IsolatePool pool(2);
+  std::vector<BatchResult> results;
+  EXPECT_EQ(4u, run_batch(pool, inputs, [&results](const BatchResult& result) {
+    results.push_back(result);
+  }));
+
+  ASSERT_EQ(5u, results.size());
+  EXPECT_EQ("1\n", results[0].output);
+  EXPECT_EQ(0u, results[0].error.find("ExecutionError"));
+  EXPECT_EQ(0u, results[1].error.find("ScopeError"));
+  EXPECT_EQ(0u, results[2].error.find("ParserError"));
+  EXPECT_TRUE(results[3].succeeded);
+  EXPECT_EQ("1", results[3].value);
+  EXPECT_EQ("Unknown exception: Cannot open file /nonexistent/file.lisp",
+            results[4].error);
+}
+
+TEST(BatchRunnerTest, ParallelOutput) {
+  // NOTE: the chunks called by the pool print to the output of the input
+  const std::vector<BatchInput> inputs{
+    {"pfor-each", "", "(pfor-each (lambda (x) (print x)) "
+                      "'(1 2 3 4 5 6 7 8) 1)"}
+  };
+
+  IsolatePool pool(2);
+  std::vector<BatchResult> results;
+  EXPECT_EQ(0u, run_batch(pool, inputs, [&results](const BatchResult& result) {
+    results.push_back(result);
+  }));
+
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ("1\n2\n3\n4\n5\n6\n7\n8\n", results[0].output);
+}
+
+TEST(BatchRunnerTest, Files) {
+  const std::string path = "lispp_batch_test.lisp";
+  {
+    std::ofstream file(path);
+    file << "(define (f x) (* x 2))\n(print (f 21))\n";
+  }
+
+  IsolatePool pool(1);
+  std::vector<BatchResult> results;
+  run_batch(pool, {BatchInput{"file", path, ""}},
+            [&results](const BatchResult& result) {
+              results.push_back(result);
+            });
+  std::remove(path.c_str());
+
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(results[0].succeeded);
+  EXPECT_EQ("42\n", results[0].output);
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+
+#include <lispp/boolean_object.h>
+#include <lispp/function_utils.h>
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+TEST(BooleanObjectTest, Singletons) {
+  EXPECT_EQ(BooleanObject::get_true(), BooleanObject::make(true).get());
+  EXPECT_EQ(BooleanObject::get_false(), BooleanObject::make(false).get());
+  EXPECT_TRUE(BooleanObject::make(true)->is_immortal());
+  EXPECT_TRUE(BooleanObject::make(true)->get_value());
+  EXPECT_FALSE(BooleanObject::make(false)->get_value());
+}
+
+TEST(BooleanObjectTest, IsTrueValue) {
+  EXPECT_TRUE(is_true_value(BooleanObject::make(true)));
+  EXPECT_FALSE(is_true_value(BooleanObject::make(false)));
+  EXPECT_TRUE(is_true_value(nullptr));
+}
+
+TEST(BooleanObjectTest, ProducedByBuiltins) {
+  VirtualMachine<> vm;
+  EXPECT_EQ(BooleanObject::get_false(), vm.eval("#f").get());
+  EXPECT_EQ(BooleanObject::get_true(), vm.eval("(< 1 2)").get());
+  EXPECT_EQ(BooleanObject::get_false(), vm.eval("(null? 1)").get());
+  EXPECT_EQ(BooleanObject::get_true(), vm.eval("(and)").get());
+}
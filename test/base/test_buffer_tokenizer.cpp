@@ -0,0 +1,179 @@
+#include <cctype>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <gtest/gtest.h>
+
+#include <lispp/buffer_tokenizer.h>
+#include <lispp/istream_tokenizer.h>
+#include <lispp/string_tokenizer.h>
+
+using namespace lispp;
+
+namespace {
+
+  // NOTE: gives the text line by line without buffered input after the
+  //       line, as interactive input does
+  class LineStreamBuf : public std::streambuf {
+  public:
+    explicit LineStreamBuf(const std::string& text) : text_(text) {}
+
+  protected:
+    int_type underflow() override {
+      if (position_ == text_.size()) {
+        return traits_type::eof();
+      }
+
+      const std::size_t line_end = text_.find('\n', position_);
+      const std::size_t end =
+          (line_end == std::string::npos ? text_.size() : line_end + 1);
+      char* begin = &text_[position_];
+      setg(begin, begin, begin + (end - position_));
+      position_ = end;
+      return traits_type::to_int_type(*begin);
+    }
+
+    std::streamsize showmanyc() override {
+      return 0;
+    }
+
+  private:
+    std::string text_;
+    std::size_t position_ = 0;
+  };
+
+  std::string make_stream_text(int lines_count) {
+    std::string text = "(a \"multi\nline\n\nstring\" b\n";
+    for (int line = 0; line < lines_count; ++line) {
+      text += "symbol" + std::to_string(line) + "\n";
+    }
+    return text;
+  }
+
+  void check_stream_tokens(std::istream& input, int lines_count) {
+    IstreamTokenizer tokenizer(input);
+
+    EXPECT_EQ(Token(TokenType::kOpenBracket), tokenizer.next_token());
+    EXPECT_EQ(Token(TokenType::kSymbol, "a"), tokenizer.next_token());
+    EXPECT_EQ(Token(TokenType::kCharacters, "multi\nline\n\nstring"),
+              tokenizer.peek_token());
+    EXPECT_EQ(Token(TokenType::kSymbol, "a"), tokenizer.current_token());
+    tokenizer.next_token();
+    EXPECT_EQ(Token(TokenType::kSymbol, "b"), tokenizer.next_token());
+    for (int line = 0; line < lines_count; ++line) {
+      EXPECT_EQ(Token(TokenType::kEndLine), tokenizer.next_token());
+      const Token& token = tokenizer.next_token();
+      ASSERT_EQ(TokenType::kSymbol, token.type);
+      ASSERT_EQ("symbol" + std::to_string(line), token.get_text());
+    }
+    EXPECT_EQ(Token(TokenType::kEndLine), tokenizer.next_token());
+    EXPECT_EQ(Token(TokenType::kEnd), tokenizer.next_token());
+  }
+
+} // namespace
+
+TEST(BufferTokenizerTest, Buffer) {
+  const std::string code = "(define (f x) \"str\" 'sym -1.5 +)\n. ,`";
+  BufferTokenizer tokenizer(code.data(), code.size());
+
+  const std::vector<Token> expected{
+    Token(TokenType::kOpenBracket),
+    Token(TokenType::kSymbol, "define"),
+    Token(TokenType::kOpenBracket),
+    Token(TokenType::kSymbol, "f"),
+    Token(TokenType::kSymbol, "x"),
+    Token(TokenType::kCloseBracket),
+    Token(TokenType::kCharacters, "str"),
+    Token(TokenType::kQuote),
+    Token(TokenType::kSymbol, "sym"),
+    Token(TokenType::kNumber, -1.5),
+    Token(TokenType::kSymbol, "+"),
+    Token(TokenType::kCloseBracket),
+    Token(TokenType::kEndLine),
+    Token(TokenType::kDot),
+    Token(TokenType::kComma),
+    Token(TokenType::kBackTick),
+    Token(TokenType::kEnd)
+  };
+  for (const auto& token : expected) {
+    EXPECT_EQ(token, tokenizer.next_token());
+  }
+  EXPECT_FALSE(tokenizer.has_more_tokens());
+  EXPECT_EQ(1, tokenizer.get_current_line());
+}
+
+TEST(BufferTokenizerTest, Errors) {
+  const std::string code = "\"not closed";
+  BufferTokenizer tokenizer(code.data(), code.size());
+  EXPECT_THROW(tokenizer.next_token(), TokenizerError);
+
+  const std::string symbol = "[";
+  BufferTokenizer symbol_tokenizer(symbol.data(), symbol.size());
+  EXPECT_THROW(symbol_tokenizer.next_token(), TokenizerError);
+}
+
+TEST(BufferTokenizerTest, StreamChunks) {
+  // NOTE: each line is a chunk, so the string and the peeked tokens span
+  //       chunks (the tokens are moved by refill)
+  LineStreamBuf line_buffer(make_stream_text(1000));
+  std::istream line_input(&line_buffer);
+  check_stream_tokens(line_input, 1000);
+
+  // NOTE: the text is longer than a chunk of the buffered input
+  const int lines_count = 20000;
+  std::stringstream ss(make_stream_text(lines_count));
+  ASSERT_GT(ss.str().size(), 2 * IstreamTokenizer::kChunkSize);
+  check_stream_tokens(ss, lines_count);
+}
+
+TEST(BufferTokenizerTest, StringClear) {
+  StringTokenizer tokenizer("1 2 3");
+  EXPECT_EQ(Token(TokenType::kNumber, 1), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kNumber, 2), tokenizer.peek_token());
+
+  tokenizer.clear();
+  tokenizer << "4";
+  EXPECT_EQ(Token(TokenType::kNumber, 4), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kEnd), tokenizer.next_token());
+}
+
+TEST(BufferTokenizerTest, TextIsKeptOnAppend) {
+  StringTokenizer tokenizer("first ");
+  EXPECT_EQ(Token(TokenType::kSymbol, "first"), tokenizer.next_token());
+
+  // NOTE: the buffer is compacted and reallocated, the text moves with it
+  tokenizer << std::string(1000, ' ') << "second third";
+  EXPECT_EQ(Token(TokenType::kSymbol, "second"), tokenizer.peek_token());
+  tokenizer << " fourth";
+  EXPECT_EQ(Token(TokenType::kSymbol, "first"), tokenizer.current_token());
+  EXPECT_EQ(Token(TokenType::kSymbol, "second"), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kSymbol, "third"), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kSymbol, "fourth"), tokenizer.next_token());
+}
+
+TEST(BufferTokenizerTest, SymbolChars) {
+  const std::string symbol_chars = "!$%&*/:<=>?~_^#.+-";
+  // NOTE: symbols are longer than a block of the vectorized scan
+  for (int c = 0; c < 256; ++c) {
+    const std::string text =
+        std::string(40, 'a') + char(c) + std::string(40, 'b');
+    BufferTokenizer tokenizer(text.data(), text.size());
+
+    const bool is_symbol_char = std::isalnum(c) ||
+        (c != 0 && symbol_chars.find(char(c)) != std::string::npos);
+    const Token& token = tokenizer.next_token();
+    EXPECT_EQ(TokenType::kSymbol, token.type) << c;
+    EXPECT_EQ(is_symbol_char ? 81u : 40u, token.text_size) << c;
+  }
+}
+
+TEST(BufferTokenizerTest, TooLongToken) {
+  // NOTE: the text isn't read
+  const char text[] = "a";
+  const std::size_t size =
+      std::size_t(std::numeric_limits<std::uint32_t>::max()) + 1;
+  EXPECT_THROW(Token(TokenType::kSymbol, text, size), TokenizerError);
+  EXPECT_EQ(1u, Token(TokenType::kSymbol, text, 1).text_size);
+}
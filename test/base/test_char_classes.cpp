@@ -0,0 +1,44 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include <lispp/char_classes.h>
+
+using namespace lispp;
+
+namespace {
+
+  // NOTE: the char is at every offset of a block of the vectorized scans
+  template<typename Scan, typename Expected>
+  void check_scan(Scan scan, Expected expected) {
+    for (int c = 0; c < 256; ++c) {
+      for (int offset = 0; offset < 40; ++offset) {
+        std::string text(offset, 'a');
+        text += char(c);
+        text += std::string(40, 'b');
+
+        const char* begin = text.data();
+        const char* end = begin + text.size();
+        EXPECT_EQ(expected(begin, end) - begin, scan(begin, end) - begin)
+            << c << " at " << offset;
+      }
+    }
+  }
+
+} // namespace
+
+TEST(CharClassesTest, SymbolChars) {
+  check_scan(skip_symbol_chars, [](const char* begin, const char* end) {
+    return skip_class(begin, end, kSymbolChar);
+  });
+}
+
+TEST(CharClassesTest, ScanStops) {
+  for (int c = 0; c < 256; ++c) {
+    const bool is_stop = (c == '(' || c == ')' || c == '"' || c == '\n');
+    EXPECT_EQ(is_stop, kCharClasses.is(char(c), kScanStop)) << c;
+  }
+
+  check_scan(skip_to_scan_stop, [](const char* begin, const char* end) {
+    return skip_to_class(begin, end, kScanStop);
+  });
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <lispp/compiler.h>
+#include <lispp/interpreter.h>
+#include <lispp/function_utils.h>
+#include <lispp/virtual_machine.h>
+
+#include "../3rdParty/lisp_test.h"
+
+using namespace lispp;
+
+class CompilerTest : public LispTest {
+protected:
+  std::shared_ptr<CodeObject> compile(const std::string& code) {
+    return Compiler(vm_->get_global_scope()).compile(vm_->parse(code));
+  }
+
+  std::vector<OpCode> opcodes(const std::shared_ptr<CodeObject>& code) {
+    std::vector<OpCode> result;
+    for (const auto& instruction : code->instructions) {
+      result.push_back(instruction.opcode);
+    }
+    return result;
+  }
+};
+
+TEST_F(CompilerTest, Constant) {
+  std::vector<OpCode> expected{OpCode::kLoadConst, OpCode::kReturn};
+  EXPECT_EQ(expected, opcodes(compile("42")));
+}
+
+TEST_F(CompilerTest, TailCall) {
+  std::vector<OpCode> expected{
+    OpCode::kLoadGlobal, OpCode::kPrepareCall, OpCode::kLoadConst,
+    OpCode::kLoadConst, OpCode::kTailCall, OpCode::kReturn
+  };
+  EXPECT_EQ(expected, opcodes(compile("(+ 1 2)")));
+}
+
+TEST_F(CompilerTest, If) {
+  std::vector<OpCode> expected{
+    OpCode::kLoadGlobal, OpCode::kJumpIfFalse, OpCode::kLoadConst,
+    OpCode::kReturn, OpCode::kLoadConst, OpCode::kReturn
+  };
+  auto code = compile("(if x 1 2)");
+  EXPECT_EQ(expected, opcodes(code));
+  EXPECT_EQ(4, code->instructions[1].arg);
+}
+
+TEST_F(CompilerTest, ShadowedSpecialForm) {
+  ExpectNoError("(define (f if) (if 1))");
+  ExpectEq("(f (lambda (x) (+ x 1)))", "2");
+}
+
+TEST_F(CompilerTest, UserMacro) {
+  ExpectNoError("(define-macro (unless c x) (list 'if c '() x))");
+
+  std::vector<OpCode> expected{
+    OpCode::kLoadGlobal, OpCode::kCallMacro, OpCode::kReturn
+  };
+  EXPECT_EQ(expected, opcodes(compile("(unless #f 1)")));
+  ExpectEq("(unless #f 1)", "1");
+}
+
+TEST_F(CompilerTest, MacroDefinedAfterCallSite) {
+  ExpectNoError("(define (f) (late 1))");
+  ExpectNoError("(define-macro (late x) x)");
+  ExpectEq("(f)", "1");
+}
+
+TEST_F(CompilerTest, MalformedSpecialForm) {
+  std::vector<OpCode> expected{
+    OpCode::kLoadGlobal, OpCode::kCallMacro, OpCode::kReturn
+  };
+  EXPECT_EQ(expected, opcodes(compile("(if)")));
+  EXPECT_THROW(vm_->eval("(if)"), MacroArgumentsError);
+}
+
+TEST_F(CompilerTest, Let) {
+  ExpectEq("(let ((x 1) (y 2)) (+ x y))", "3");
+  ExpectEq("(+ 1 (let ((x 1) (y 2)) (+ x y)))", "4");
+  ExpectUndefinedVariable("x");
+}
+
+TEST_F(CompilerTest, DeepTailRecursion) {
+  ExpectNoError("(define (loop n) (if (= n 0) 'done (loop (- n 1))))");
+  ExpectEq("(loop 300000)", "done");
+}
+
+TEST_F(CompilerTest, TailCallInCondAndOr) {
+  ExpectNoError("(define (f n) "
+                "  (cond ((= n 0) 'done) (#t (and #t (or #f (f (- n 1)))))))");
+  ExpectEq("(f 300000)", "done");
+}
+
+TEST_F(CompilerTest, LexicalAddressing) {
+  std::vector<OpCode> expected{
+    OpCode::kLoadGlobal, OpCode::kPrepareCall, OpCode::kLoadLocal,
+    OpCode::kLoadLocal, OpCode::kTailCall, OpCode::kReturn
+  };
+  auto code = compile("(let ((x 1)) (let ((y 2)) (+ x y)))");
+  // NOTE: skip the let prologues
+  std::vector<Instruction> body(code->instructions.begin() + 4,
+                                code->instructions.end());
+  std::vector<OpCode> body_opcodes;
+  for (const auto& instruction : body) {
+    body_opcodes.push_back(instruction.opcode);
+  }
+  EXPECT_EQ(expected, body_opcodes);
+  EXPECT_EQ(2, body[0].extra_arg);
+  EXPECT_EQ(1, body[2].extra_arg);
+  EXPECT_EQ(0, body[3].extra_arg);
+}
+
+TEST_F(CompilerTest, Closures) {
+  ExpectNoError("(define (make-counter) "
+                "  (let ((n 0)) (lambda () (set! n (+ n 1)) n)))");
+  ExpectNoError("(define counter (make-counter))");
+  ExpectNoError("(counter)");
+  ExpectEq("(counter)", "2");
+  ExpectEq("((make-counter))", "1");
+
+  ExpectNoError("(define (f x) (define y (* x 2)) (lambda (z) (+ x y z)))");
+  ExpectEq("((f 1) 10)", "13");
+}
+
+TEST_F(CompilerTest, DefinedNames) {
+  ExpectNoError("(define (f x) (define x 5) x)");
+  ExpectEq("(f 1)", "5");
+
+  ExpectNoError("(define (g) (define (h) w) (define w 7) (h))");
+  ExpectEq("(g)", "7");
+
+  ExpectNoError("(define q 3)");
+  ExpectNoError("(define (set-q) (set! q 4) q)");
+  ExpectEq("(set-q)", "4");
+  ExpectEq("q", "4");
+}
+
+TEST_F(CompilerTest, RuntimeDefines) {
+  ExpectNoError("(define (f) (eval '(define z 1)) z)");
+  ExpectEq("(f)", "1");
+  ExpectUndefinedVariable("z");
+
+  ExpectNoError("(define (g) "
+                "  (let ((x 1)) (eval '(define w 2)) (set! w 3) (+ x w)))");
+  ExpectEq("(g)", "4");
+  ExpectUndefinedVariable("w");
+
+  ExpectNoError("(define (h) (eval '(define v 5)) (lambda () v))");
+  ExpectEq("((h))", "5");
+}
+
+TEST_F(CompilerTest, DuplicatedLetNames) {
+  ExpectEq("(let ((x 1) (x 2)) x)", "2");
+}
+
+TEST_F(CompilerTest, GlobalCacheInvalidation) {
+  ExpectNoError("(define (f) 1)");
+  ExpectNoError("(define (g) (f))");
+  ExpectEq("(g)", "1");
+  ExpectEq("(g)", "1");
+
+  ExpectNoError("(define (f) 2)");
+  ExpectEq("(g)", "2");
+
+  ExpectNoError("(set! f (lambda () 3))");
+  ExpectEq("(g)", "3");
+
+  vm_->parse("(set! f (lambda () 4))").safe_eval(vm_->get_global_scope());
+  ExpectEq("(g)", "4");
+}
+
+TEST_F(CompilerTest, GlobalCacheVersion) {
+  ExpectNoError("(define x 1)");
+  ExpectNoError("(define (f) x)");
+  ExpectEq("(f)", "1");
+
+  // NOTE: defines in frames don't invalidate the caches
+  ExpectNoError("(define (g) (define y 2) (f))");
+  const ScopePtr global_scope = vm_->get_global_scope();
+  const auto version = global_scope->get_version();
+  ExpectEq("(g)", "1");
+  EXPECT_EQ(version, global_scope->get_version());
+
+  // NOTE: the versions of other VMs are separate
+  VirtualMachine<> other_vm;
+  other_vm.eval("(define (h) x)");
+  other_vm.eval("(define x 1)");
+  other_vm.eval("(h)");
+  other_vm.eval("(define x 2)");
+  EXPECT_EQ(version, global_scope->get_version());
+
+  ExpectNoError("(define x 5)");
+  EXPECT_NE(version, global_scope->get_version());
+  ExpectEq("(f)", "5");
+}
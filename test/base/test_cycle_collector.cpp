@@ -0,0 +1,94 @@
+#include <thread>
+#include <gtest/gtest.h>
+
+#include <lispp/callable_object.h>
+#include <lispp/cycle_collector.h>
+#include <lispp/virtual_machine.h>
+
+#include "../3rdParty/lisp_test.h"
+
+using namespace lispp;
+
+class CycleCollectorTest : public LispTest {
+protected:
+  void SetUp() override {
+    LispTest::SetUp();
+    collector.set_threshold(0);
+    collector.collect();
+  }
+
+  void TearDown() override {
+    collector.set_threshold(CycleCollector::kDefaultThreshold);
+    LispTest::TearDown();
+  }
+
+  CycleCollector& collector = CycleCollector::get_current();
+};
+
+TEST_F(CycleCollectorTest, LocalDefinitions) {
+  ExpectNoError("(define (f x) (define (g) x) (g))");
+  collector.collect();
+
+  for (int call_index = 0; call_index < 100; ++call_index) {
+    ExpectEq("(f 1)", "1");
+  }
+
+  auto stats = collector.collect();
+  EXPECT_EQ(1u, stats.collections);
+  EXPECT_EQ(100u, stats.scopes_freed);
+  EXPECT_EQ(100u, stats.objects_freed);
+  EXPECT_EQ(0u, collector.collect().scopes_freed);
+}
+
+TEST_F(CycleCollectorTest, TreeWalkingEval) {
+  vm_->parse("(define (f x) (define (g) x) (g))")
+      .safe_eval(vm_->get_global_scope());
+  collector.collect();
+
+  for (int call_index = 0; call_index < 10; ++call_index) {
+    vm_->parse("(f 1)").safe_eval(vm_->get_global_scope());
+  }
+
+  EXPECT_EQ(10u, collector.collect().scopes_freed);
+}
+
+TEST_F(CycleCollectorTest, ReachableClosuresSurvive) {
+  ExpectNoError("(define (make-counter) "
+                "  (define n 0) "
+                "  (define (next) (set! n (+ n 1)) n) "
+                "  next)");
+  ExpectNoError("(define counter (make-counter))");
+  ExpectNoError("(counter)");
+
+  auto counter = vm_->eval("(make-counter)");
+  collector.collect();
+
+  ExpectEq("(counter)", "2");
+  EXPECT_EQ("1", counter->as_callable()->call(vm_->get_global_scope(), {})
+                     ->to_string());
+}
+
+TEST_F(CycleCollectorTest, Threshold) {
+  ExpectNoError("(define (f x) (define (g) x) (g))");
+  collector.set_threshold(10);
+
+  const auto collections = collector.get_stats().collections;
+  for (int call_index = 0; call_index < 30; ++call_index) {
+    ExpectNoError("(f 1)");
+  }
+
+  EXPECT_LT(collections, collector.get_stats().collections);
+  EXPECT_GE(10u, collector.get_tracked_count());
+}
+
+TEST(CycleCollectorThreadTest, ScopeOutlivesThread) {
+  ScopePtr scope;
+  std::thread([&scope]() {
+    scope = ScopePtr(new Scope);
+    CycleCollector::get_current().track(scope.get());
+  }).join();
+
+  // NOTE: the collector of the thread is gone, the scope is detached
+  EXPECT_EQ(1, scope->get_ref_count());
+  scope.reset();
+}
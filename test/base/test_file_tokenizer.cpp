@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include <lispp/file_tokenizer.h>
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+class FileTokenizerTest : public ::testing::Test {
+protected:
+  ~FileTokenizerTest() {
+    std::remove(kPath);
+  }
+
+  void write_file(const std::string& content) {
+    std::ofstream file(kPath);
+    file << content;
+  }
+
+  const char* const kPath = "lispp_file_tokenizer_test.lisp";
+};
+
+TEST_F(FileTokenizerTest, Mapped) {
+  write_file("(a \"b c\"\n 1.5)");
+  FileTokenizer tokenizer(kPath);
+  EXPECT_TRUE(tokenizer.is_mapped());
+
+  EXPECT_EQ(Token(TokenType::kOpenBracket), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kSymbol, "a"), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kCharacters, "b c"), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kEndLine), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kNumber, 1.5), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kCloseBracket), tokenizer.next_token());
+  EXPECT_EQ(Token(TokenType::kEnd), tokenizer.next_token());
+  EXPECT_FALSE(tokenizer.has_more_tokens());
+}
+
+TEST_F(FileTokenizerTest, Empty) {
+  write_file("");
+  FileTokenizer tokenizer(kPath);
+  EXPECT_FALSE(tokenizer.has_more_tokens());
+  EXPECT_EQ(Token(TokenType::kEnd), tokenizer.next_token());
+}
+
+TEST_F(FileTokenizerTest, Missing) {
+  EXPECT_THROW(FileTokenizer("lispp_missing_file.lisp"), TokenizerError);
+}
+
+TEST_F(FileTokenizerTest, Eval) {
+  write_file("(define (square x) (* x x))\n(square 7)\n");
+  VirtualMachine<FileTokenizer> vm(kPath);
+  EXPECT_EQ("49", vm.eval_all()->to_string());
+}
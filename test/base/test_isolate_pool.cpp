@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+
+#include <lispp/isolate_pool.h>
+
+using namespace lispp;
+
+TEST(IsolatePoolTest, Eval) {
+  IsolatePool pool(2);
+  EXPECT_EQ(2u, pool.get_threads_count());
+  EXPECT_EQ("3", pool.eval("(define x 1) (+ x 2)").get());
+  EXPECT_EQ("()", pool.eval("'()").get());
+}
+
+TEST(IsolatePoolTest, Exceptions) {
+  IsolatePool pool(1);
+  auto result = pool.eval("(car 1)");
+  EXPECT_THROW(result.get(), ExecutionError);
+  EXPECT_EQ("1", pool.eval("1").get());
+}
+
+TEST(IsolatePoolTest, IsolatesInParallel) {
+  const std::string code =
+      "(define (square x) (* x x))"
+      "(define (make-adder n) (lambda (x) (+ x n)))"
+      "(define lst (map (make-adder 1) (make-list 1000 1)))"
+      "(set! car cdr)"
+      "(list (foldr + (map square lst)) (max 1 (length lst)) (car '(1 2)))";
+
+  IsolatePool pool(4);
+  std::vector<std::future<std::string>> results;
+  for (int task = 0; task < 64; ++task) {
+    results.push_back(pool.eval(code));
+  }
+
+  for (auto& result : results) {
+    EXPECT_EQ("(4000 1000 (2))", result.get());
+  }
+
+  // NOTE: isolates don't see the changes of each other
+  EXPECT_EQ("1", pool.eval("(car '(1 2))").get());
+}
+
+TEST(IsolatePoolTest, Submit) {
+  IsolatePool pool;
+  auto result = pool.submit([](VirtualMachine<>& vm) {
+    vm.eval("(define x 5)");
+    return vm.get_global_scope()->get_value("x")->to_string();
+  });
+  EXPECT_EQ("5", result.get());
+}
+
+TEST(IsolatePoolTest, WorkStealing) {
+  IsolatePool pool(2);
+  const int kShortTasksCount = 16;
+  std::atomic<int> done_count(0);
+
+  // NOTE: the long task waits for the short ones queued behind it, so
+  //       they have to be stolen by the other worker
+  auto long_task = pool.submit([&done_count](VirtualMachine<>&) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done_count < kShortTasksCount &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return done_count.load();
+  });
+
+  for (int task = 0; task < kShortTasksCount; ++task) {
+    pool.submit([&done_count](VirtualMachine<>& vm) {
+      vm.eval("(+ 1 2)");
+      return ++done_count;
+    });
+  }
+
+  EXPECT_EQ(kShortTasksCount, long_task.get());
+  EXPECT_GT(pool.get_steals_count(), 0u);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <lispp/builtins.h>
+#include <lispp/user_callable_object.h>
+#include <lispp/virtual_machine.h>
+
+#include "../3rdParty/lisp_test.h"
+
+using namespace lispp;
+
+class ListBuiltinsTest : public LispTest {
+protected:
+  ListBuiltinsTest() {
+    init_scope_with_reference_stdlibs(reference_vm.get_global_scope());
+  }
+
+  // NOTE: native functions must agree with the reference definitions
+  void expect_same(const std::string& code) {
+    auto expected = reference_vm.eval(code);
+    SCOPED_TRACE(code);
+    ExpectEq(code, (expected.valid() ? expected->to_string() : "()"));
+  }
+
+  VirtualMachine<> reference_vm;
+};
+
+TEST_F(ListBuiltinsTest, Native) {
+  auto is_native = [](VirtualMachine<>& vm, const std::string& name) {
+    auto function = vm.get_global_scope()->get_value(name)->as_callable();
+    return (dynamic_cast<UserCallableObject*>(function) == nullptr &&
+            function->as_compiled_callable() == nullptr);
+  };
+
+  EXPECT_TRUE(is_native(*vm_, "map"));
+  EXPECT_FALSE(is_native(reference_vm, "map"));
+}
+
+TEST_F(ListBuiltinsTest, SameAsReference) {
+  const std::vector<std::string> kForms{
+    "(length '())",
+    "(length '(1 2 3))",
+    "(list-tail '(1 2 3) 0)",
+    "(list-tail '(1 2 3) 2)",
+    "(list-ref '(1 2 3) 1)",
+    "(append '() '(1))",
+    "(append '(1 2) '(3 4))",
+    "(append '(1 2) 3)",
+    "(reverse '())",
+    "(reverse '(1 2 3))",
+    "(map (lambda (x) (* x x)) '())",
+    "(map (lambda (x) (* x x)) '(1 2 3))",
+    "(filter (lambda (x) (> x 1)) '(1 2 3 0 5))",
+    "(filter (lambda (x) #f) '(1 2 3))",
+    "(member 2 '(1 2 3))",
+    "(member 4 '(1 2 3))",
+    "(foldr + '())",
+    "(foldr + '(1))",
+    "(foldr cons '(1 2 3))",
+    "(foldr - '(1 2 3 4))",
+    "(make-list 0 1)",
+    "(make-list 3 'x)",
+    "(take '(1 2 3 4) 2)",
+    "(max 1 5 2)",
+    "(min 4 1 2)"
+  };
+
+  for (const auto& form : kForms) {
+    expect_same(form);
+  }
+}
+
+TEST_F(ListBuiltinsTest, Errors) {
+  ExpectRuntimeError("(length '(1 . 2))");
+  ExpectRuntimeError("(list-tail '(1 2) 3)");
+  ExpectRuntimeError("(map 1 '(1 2))");
+  ExpectRuntimeError("(member 'a '(1 2))");
+  ExpectRuntimeError("(make-list -1 0)");
+}
+
+TEST_F(ListBuiltinsTest, LongLists) {
+  ExpectNoError("(define lst (make-list 300000 1))");
+  ExpectEq("(length lst)", "300000");
+  ExpectEq("(length (map (lambda (x) (+ x 1)) lst))", "300000");
+  ExpectEq("(length (append lst lst))", "600000");
+  ExpectEq("(length (filter (lambda (x) (> x 1)) lst))", "0");
+  ExpectEq("(member 2 lst)", "#f");
+  ExpectEq("(foldr + lst)", "300000");
+  ExpectEq("(list-ref (reverse lst) 299999)", "1");
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <lispp/user_callable_object.h>
+#include <lispp/virtual_machine.h>
+
+#include "../3rdParty/lisp_test.h"
+
+using namespace lispp;
+
+class MacroExpansionTest : public LispTest {
+protected:
+  std::size_t get_expansions_count(const std::string& name) {
+    auto macro = vm_->get_global_scope()->get_value(name);
+    return static_cast<UserCallableObject*>(macro->as_callable())
+        ->get_expansions_count();
+  }
+};
+
+TEST_F(MacroExpansionTest, ExpandedOncePerCallSite) {
+  ExpectNoError("(define expansions 0)");
+  ExpectNoError("(define (note x) (set! expansions (+ expansions 1)) x)");
+  ExpectNoError("(define-macro (twice x) (note (list '+ x x)))");
+  ExpectNoError("(define (f n) (twice n))");
+
+  ExpectEq("(f 1)", "2");
+  ExpectEq("(f 2)", "4");
+  ExpectEq("expansions", "1");
+  EXPECT_EQ(1u, get_expansions_count("twice"));
+
+  ExpectEq("(twice 3)", "6");
+  ExpectEq("expansions", "2");
+}
+
+TEST_F(MacroExpansionTest, SeveralExpressions) {
+  ExpectNoError("(define calls 0)");
+  // NOTE: the intermediate expansion is evaluated on every call
+  ExpectNoError("(define-macro (add x y) "
+                "  '(set! calls (+ calls 1)) "
+                "  (list '+ x y))");
+  ExpectNoError("(define (f n) (add n 1))");
+
+  ExpectEq("(f 1)", "2");
+  ExpectEq("(f 2)", "3");
+  ExpectEq("calls", "2");
+  EXPECT_EQ(0u, get_expansions_count("add"));
+}
+
+TEST_F(MacroExpansionTest, Redefinition) {
+  ExpectNoError("(define-macro (m x) (list '+ x 1))");
+  ExpectNoError("(define (f n) (m n))");
+  ExpectEq("(f 1)", "2");
+  ExpectEq("(f 2)", "3");
+
+  ExpectNoError("(define-macro (m x) (list '* x 10))");
+  ExpectEq("(f 2)", "20");
+}
+
+TEST_F(MacroExpansionTest, MutableState) {
+  ExpectNoError("(define k 1)");
+  ExpectNoError("(define-macro (m) k)");
+  ExpectNoError("(define (f) (m))");
+  ExpectEq("(f)", "1");
+  ExpectNoError("(set! k 2)");
+  ExpectEq("(f)", "2");
+  ExpectNoError("(define k 3)");
+  ExpectEq("(f)", "3");
+  ExpectEq("(f)", "3");
+  EXPECT_EQ(1u, get_expansions_count("m"));
+
+  // NOTE: slots of the closure are not versioned
+  ExpectNoError("(define (make-g n) "
+                "  (define-macro (m2) n) "
+                "  (lambda (x) (set! n x) (m2)))");
+  ExpectNoError("(define g (make-g 0))");
+  ExpectEq("(g 1)", "1");
+  ExpectEq("(g 2)", "2");
+}
+
+TEST_F(MacroExpansionTest, TreeWalkingEval) {
+  ExpectNoError("(define-macro (m x) (list '+ x 1))");
+  vm_->parse("(define (f n) (m n))").safe_eval(vm_->get_global_scope());
+  for (int n = 0; n < 10; ++n) {
+    auto result = vm_->parse("(f " + std::to_string(n) + ")")
+        .safe_eval(vm_->get_global_scope());
+    EXPECT_EQ(std::to_string(n + 1), result->to_string());
+  }
+  EXPECT_EQ(1u, get_expansions_count("m"));
+}
@@ -0,0 +1,46 @@
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include <lispp/number_object.h>
+
+using namespace lispp;
+
+TEST(NumberObjectTest, SmallIntegersAreShared) {
+  auto number = NumberObject::make(42);
+  EXPECT_EQ(number.get(), NumberObject::make(42).get());
+  EXPECT_TRUE(number->is_immortal());
+  EXPECT_EQ(42, number->get_value());
+
+  EXPECT_EQ(NumberObject::make(NumberObject::kSmallIntegerMin).get(),
+            NumberObject::make(NumberObject::kSmallIntegerMin).get());
+  EXPECT_EQ(NumberObject::make(NumberObject::kSmallIntegerMax).get(),
+            NumberObject::make(NumberObject::kSmallIntegerMax).get());
+}
+
+TEST(NumberObjectTest, OtherNumbersAreAllocated) {
+  auto fraction = NumberObject::make(0.5);
+  EXPECT_FALSE(fraction->is_immortal());
+  EXPECT_NE(fraction.get(), NumberObject::make(0.5).get());
+  EXPECT_EQ(0.5, fraction->get_value());
+
+  auto big = NumberObject::make(NumberObject::kSmallIntegerMax + 1);
+  EXPECT_FALSE(big->is_immortal());
+  EXPECT_EQ(*big, *NumberObject::make(NumberObject::kSmallIntegerMax + 1));
+}
+
+TEST(NumberObjectTest, NegativeZeroIsNotShared) {
+  auto negative_zero = NumberObject::make(-0.0);
+  EXPECT_FALSE(negative_zero->is_immortal());
+  EXPECT_TRUE(std::signbit(negative_zero->get_value()));
+  EXPECT_FALSE(std::signbit(NumberObject::make(0.0)->get_value()));
+}
+
+TEST(NumberObjectTest, ImmortalRefCount) {
+  auto number = NumberObject::make(1);
+  const int ref_count = number->get_ref_count();
+  {
+    ObjectPtr<> copy(number);
+    EXPECT_EQ(ref_count, number->get_ref_count());
+  }
+  EXPECT_EQ(ref_count, number->get_ref_count());
+}
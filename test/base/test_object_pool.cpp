@@ -0,0 +1,95 @@
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <lispp/cons_object.h>
+#include <lispp/object_pool.h>
+
+using namespace lispp;
+
+namespace {
+
+  // NOTE: the allocator type is process-wide, so the checks are run in
+  //       a child process (see ObjectPoolTest)
+  bool check_pool() {
+    if (!ObjectPool::set_allocator_type(ObjectAllocatorType::kPool)) {
+      return false;
+    }
+
+    void* first = ObjectPool::allocate(sizeof(ConsObject));
+    void* second = ObjectPool::allocate(sizeof(ConsObject));
+    if (first == nullptr || second == nullptr || first == second) {
+      return false;
+    }
+
+    ObjectPool::deallocate(first, sizeof(ConsObject));
+    if (ObjectPool::allocate(sizeof(ConsObject)) != first) {
+      return false;
+    }
+
+    Object* cons = new ConsObject;
+    delete cons;
+    if (new ConsObject != cons) {
+      return false;
+    }
+
+    return !ObjectPool::set_allocator_type(ObjectAllocatorType::kSystem);
+  }
+
+  std::vector<void*> allocate_on_thread(std::size_t count) {
+    std::vector<void*> blocks;
+    std::thread([&blocks, count]() {
+      for (std::size_t index = 0; index < count; ++index) {
+        blocks.push_back(ObjectPool::allocate(sizeof(ConsObject)));
+      }
+    }).join();
+
+    return blocks;
+  }
+
+  // NOTE: blocks allocated by a thread and freed by another one are reused
+  //       by the next threads
+  bool check_shared_blocks() {
+    const std::size_t kCount = 100000;
+    std::vector<void*> blocks = allocate_on_thread(kCount);
+    for (void* block : blocks) {
+      ObjectPool::deallocate(block, sizeof(ConsObject));
+    }
+
+    const std::set<void*> freed_blocks(blocks.begin(), blocks.end());
+    std::size_t reused_count = 0;
+    for (void* block : allocate_on_thread(kCount)) {
+      reused_count += freed_blocks.count(block);
+    }
+
+    return reused_count > kCount / 2;
+  }
+
+} // namespace
+
+TEST(ObjectPoolTest, ReusesBlocks) {
+  EXPECT_EXIT(exit(check_pool() ? 0 : 1), ::testing::ExitedWithCode(0), "");
+}
+
+TEST(ObjectPoolTest, SharesFreedBlocks) {
+  EXPECT_EXIT(exit(ObjectPool::set_allocator_type(ObjectAllocatorType::kPool) &&
+                   check_shared_blocks() ? 0 : 1),
+              ::testing::ExitedWithCode(0), "");
+}
+
+#if defined(__SANITIZE_ADDRESS__)
+TEST(ObjectPoolTest, PoisonsFreedBlocks) {
+  EXPECT_DEATH({
+    Object* cons = new ConsObject;
+    delete cons;
+    *reinterpret_cast<volatile char*>(cons) = 0;
+  }, "use-after-poison");
+}
+#endif
+
+TEST(ObjectPoolTest, LargeObjects) {
+  void* block = ObjectPool::allocate(1024);
+  ASSERT_NE(nullptr, block);
+  ObjectPool::deallocate(block, 1024);
+}
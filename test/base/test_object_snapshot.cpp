@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <lispp/compiled_callable_object.h>
+#include <lispp/object_snapshot.h>
+#include <lispp/objects_all.h>
+#include <lispp/virtual_machine.h>
+
+#include "../3rdParty/lisp_test.h"
+
+using namespace lispp;
+
+class ObjectSnapshotTest : public LispTest {
+protected:
+  ObjectPtr<> copy(const ObjectPtr<>& object) {
+    auto snapshot = ObjectSnapshot::take(ArgsSpan(&object, 1));
+    EXPECT_EQ(1u, snapshot.get_roots_count());
+    return snapshot.restore().front();
+  }
+
+  // NOTE: calls the copy of the function in another VM
+  std::string call_copy(const std::string& function_code,
+                        const std::string& arg_code) {
+    auto function = vm_->eval(function_code);
+    auto arg = vm_->eval(arg_code);
+    ObjectPtr<> roots[] = {function, arg};
+    auto snapshot = ObjectSnapshot::take(ArgsSpan(roots, 2));
+
+    VirtualMachine<> other_vm;
+    auto copies = snapshot.restore();
+    auto result = copies[0]->as_callable()->call(
+        other_vm.get_global_scope(), ArgsSpan(&copies[1], 1));
+    return (result.valid() ? result->to_string() : "()");
+  }
+};
+
+TEST_F(ObjectSnapshotTest, Data) {
+  auto data = vm_->eval("'(1 \"str\" sym #t (2 . 3) '(a ,b `c) ())");
+  auto data_copy = copy(data);
+  EXPECT_EQ(data->to_string(), data_copy->to_string());
+  EXPECT_NE(data.get(), data_copy.get());
+
+  // NOTE: symbols are immortal and shared
+  auto symbol = vm_->eval("'sym");
+  EXPECT_EQ(symbol.get(), copy(symbol).get());
+  EXPECT_FALSE(copy(nullptr).valid());
+}
+
+TEST_F(ObjectSnapshotTest, SharedStructureAndCycles) {
+  ExpectNoError("(define tail '(2 3))");
+  auto shared = vm_->eval("(cons tail tail)");
+  auto shared_copy = copy(shared);
+  EXPECT_EQ(shared_copy->as_cons()->get_left_value().get(),
+            shared_copy->as_cons()->get_right_value().get());
+  EXPECT_NE(shared->as_cons()->get_left_value().get(),
+            shared_copy->as_cons()->get_left_value().get());
+
+  ExpectNoError("(define cycle-tail (list 2))");
+  ExpectNoError("(define cycle (cons 1 cycle-tail))");
+  vm_->eval("(set-cdr! cycle-tail cycle)");
+  auto cycle_copy = copy(vm_->eval("cycle"));
+  auto second = cycle_copy->as_cons()->get_right_value();
+  EXPECT_EQ(cycle_copy.get(), second->as_cons()->get_right_value().get());
+  ExpectNoError("(set-cdr! cycle-tail '())");
+  second->as_cons()->set_right_value(nullptr);
+}
+
+TEST_F(ObjectSnapshotTest, LongLists) {
+  auto lst = vm_->eval("(make-list 300000 1)");
+  auto lst_copy = copy(lst);
+  auto length = vm_->get_global_scope()->get_value("length")->as_callable();
+  EXPECT_EQ("300000", length->call(vm_->get_global_scope(),
+                                   ArgsSpan(&lst_copy, 1))->to_string());
+}
+
+TEST_F(ObjectSnapshotTest, Closures) {
+  ExpectNoError("(define (make-adder n) (lambda (x) (+ x n)))");
+  EXPECT_EQ("3", call_copy("(make-adder 2)", "1"));
+
+  ExpectNoError("(define (square x) (* x x))");
+  EXPECT_EQ("(1 4 9)", call_copy("(lambda (lst) (map square lst))",
+                                 "'(1 2 3)"));
+
+  ExpectNoError("(define (fact n) (if (= n 0) 1 (* n (fact (- n 1)))))");
+  EXPECT_EQ("120", call_copy("fact", "5"));
+
+  ExpectNoError("(define-macro (twice x) (list '* 2 x))");
+  EXPECT_EQ("8", call_copy("(lambda (x) (twice x))", "4"));
+
+  // NOTE: the copies are independent
+  ExpectNoError("(define counter 0)");
+  EXPECT_EQ("1", call_copy("(lambda (x) (set! counter (+ counter x)) "
+                           "counter)", "1"));
+  ExpectEq("counter", "0");
+}
+
+TEST_F(ObjectSnapshotTest, OnlyReferencedGlobals) {
+  ExpectNoError("(define unused (make-list 1000 1))");
+  ExpectNoError("(define used 2)");
+  auto function = vm_->eval("(lambda () used)");
+  auto snapshot = ObjectSnapshot::take(ArgsSpan(&function, 1));
+
+  VirtualMachine<> other_vm;
+  auto function_copy = snapshot.restore().front();
+  auto* callable = function_copy->as_callable();
+  EXPECT_EQ("2", callable->call(other_vm.get_global_scope(),
+                                ArgsSpan())->to_string());
+
+  auto closure = callable->as_compiled_callable()->get_closure();
+  EXPECT_TRUE(closure->has_value("used"));
+  EXPECT_FALSE(closure->has_value("unused"));
+}
@@ -0,0 +1,85 @@
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include <lispp/builtins.h>
+#include <lispp/isolate_pool.h>
+#include <lispp/virtual_machine.h>
+
+#include "../3rdParty/lisp_test.h"
+
+using namespace lispp;
+
+class ParallelMapTest : public LispTest {};
+
+TEST_F(ParallelMapTest, SameAsMap) {
+  ExpectNoError("(define (square x) (* x x))");
+  ExpectNoError("(define lst (map (lambda (x) (+ x 1)) (make-list 1000 1)))");
+  const auto squares = vm_->eval("(map square lst)")->to_string();
+  ExpectEq("(pmap square lst)", squares);
+  ExpectEq("(pmap square lst 7)", squares);
+  ExpectEq("(pmap square lst 1000)", squares);
+
+  ExpectEq("(pmap square '())", "()");
+  ExpectEq("(pmap square '(1 2 3) 1)", "(1 4 9)");
+  ExpectEq("(pmap (lambda (x) (car x)) '((\"a\") ((b)) (3)) 1)",
+           "(\"a\" (b) 3)");
+}
+
+TEST_F(ParallelMapTest, Closures) {
+  ExpectNoError("(define (make-adder n) (lambda (x) (+ x n)))");
+  ExpectNoError("(define add-two (make-adder 2))");
+  ExpectEq("(pmap add-two '(1 2 3 4) 1)", "(3 4 5 6)");
+
+  // NOTE: closures in the results are copied back
+  ExpectNoError("(define adders (pmap make-adder '(1 2 3 4) 1))");
+  ExpectEq("(map (lambda (f) (f 10)) adders)", "(11 12 13 14)");
+}
+
+TEST_F(ParallelMapTest, ForEach) {
+  ExpectEq("(pfor-each (lambda (x) (* x x)) '(1 2 3 4) 1)", "()");
+
+  // NOTE: all the chunks are called with copies of the function
+  ExpectNoError("(define count 0)");
+  ExpectNoError("(pfor-each (lambda (x) (set! count (+ count 1))) "
+                "'(1 2 3 4) 2)");
+  ExpectNoError("(pfor-each (lambda (x) (set! count (+ count 1))) '(1 2 3 4))");
+  ExpectEq("count", "0");
+}
+
+TEST_F(ParallelMapTest, Nested) {
+  ExpectEq("(pmap (lambda (x) (pmap (lambda (y) (* x y)) '(1 2) 1)) "
+           "'(1 2 3) 1)", "((1 2) (2 4) (3 6))");
+}
+
+TEST_F(ParallelMapTest, Errors) {
+  ExpectRuntimeError("(pmap car '(1 2 3 4) 1)");
+  ExpectRuntimeError("(pmap car '((1) (2) 3 (4)) 1)");
+  ExpectRuntimeError("(pmap 1 '(1 2))");
+  ExpectRuntimeError("(pmap car '(1 . 2))");
+  ExpectRuntimeError("(pmap car '((1)) 0)");
+  ExpectRuntimeError("(pfor-each car '((1)) 1.5)");
+  ExpectEq("(pmap car '((1) (2)) 1)", "(1 2)");
+  // NOTE: the grain is greater than SIZE_MAX
+  ExpectEq("(pmap car '((1) (2)) (* 1000000000000 1000000000000000000000))",
+           "(1 2)");
+}
+
+TEST_F(ParallelMapTest, Output) {
+  std::stringstream output;
+  builtins::set_output_stream(&output);
+  ExpectNoError("(pfor-each (lambda (x) (print x)) '(1 2 3 4 5 6) 2)");
+  EXPECT_EQ("1\n2\n3\n4\n5\n6\n", output.str());
+
+  // NOTE: nothing is printed after the first error
+  output.str("");
+  ExpectRuntimeError("(pfor-each (lambda (x) (print x) (car x)) "
+                     "'((1) 2 (3) (4)) 1)");
+  builtins::set_output_stream(nullptr);
+  EXPECT_EQ("(1)\n2\n", output.str());
+}
+
+TEST_F(ParallelMapTest, InIsolates) {
+  IsolatePool pool(2);
+  auto result = pool.eval("(pmap (lambda (x) (* 2 x)) '(1 2 3) 1)");
+  EXPECT_EQ("(2 4 6)", result.get());
+}
@@ -0,0 +1,122 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <lispp/isolate_pool.h>
+#include <lispp/parallel_parser.h>
+#include <lispp/parser.h>
+#include <lispp/string_tokenizer.h>
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+namespace {
+
+  std::vector<std::string> parse_sequentially(const std::string& text) {
+    StringTokenizer tokenizer(text);
+    Parser parser(&tokenizer);
+    std::vector<std::string> forms;
+    while (parser.has_objects()) {
+      auto form = parser.parse_object();
+      forms.push_back(form.valid() ? form->to_string() : "()");
+    }
+
+    return forms;
+  }
+
+  std::vector<std::string> to_strings(const std::vector<ObjectPtr<>>& forms) {
+    std::vector<std::string> result;
+    for (const auto& form : forms) {
+      result.push_back(form.valid() ? form->to_string() : "()");
+    }
+
+    return result;
+  }
+
+} // namespace
+
+class ParallelParserTest : public ::testing::Test {
+protected:
+  IsolatePool pool{4};
+};
+
+TEST_F(ParallelParserTest, SameAsSequential) {
+  const std::string text =
+      "(define x 1) 2 \"a (string\" (a \"b)\" . c)\n"
+      "'\n(1 2) `(a ,b ,(c)) #t #f ()\n"
+      "\n((nested (list)) \"multi\nline\") sym -3.5 '  'x";
+
+  // NOTE: chunk size 1 cuts at every possible place
+  for (std::size_t chunk_size : {1, 5, 16, 1000}) {
+    ParallelParser parser(&pool, chunk_size);
+    EXPECT_EQ(parse_sequentially(text),
+              to_strings(parser.parse_all(text.data(), text.size())))
+        << chunk_size;
+    EXPECT_EQ(4, parser.get_current_line());
+  }
+}
+
+TEST_F(ParallelParserTest, ManyForms) {
+  std::string text;
+  for (int i = 0; i < 10000; ++i) {
+    text += "(item " + std::to_string(i) + " \"" + std::to_string(i) +
+            "\")\n";
+  }
+
+  ParallelParser parser(&pool, 100);
+  const auto forms = parser.parse_all(text.data(), text.size());
+  EXPECT_EQ(parse_sequentially(text), to_strings(forms));
+  EXPECT_EQ(10000, parser.get_current_line());
+}
+
+TEST_F(ParallelParserTest, Errors) {
+  const std::string text = "1\n2\n(3\n4 \"5)\"\n6))\n7\n8";
+  ParallelParser parser(&pool, 1);
+
+  std::vector<ObjectPtr<>> forms;
+  EXPECT_THROW(parser.parse_all(text.data(), text.size(),
+                                [&forms](const ObjectPtr<>& form) {
+                                  forms.push_back(form);
+                                }),
+               ParserError);
+  EXPECT_EQ((std::vector<std::string>{"1", "2", "(3 4 \"5)\" 6)"}),
+            to_strings(forms));
+
+  StringTokenizer tokenizer(text);
+  Parser sequential_parser(&tokenizer);
+  EXPECT_THROW(while (sequential_parser.has_objects()) {
+                 sequential_parser.parse_object();
+               },
+               ParserError);
+  EXPECT_EQ(tokenizer.get_current_line(), parser.get_current_line());
+
+  const std::string unterminated = "1 2 \"3 4";
+  EXPECT_THROW(parser.parse_all(unterminated.data(), unterminated.size()),
+               TokenizerError);
+}
+
+TEST_F(ParallelParserTest, EvalForms) {
+  const std::string text =
+      "(define (square x) (* x x))\n(define y (square 3))\n(+ y 1)";
+  VirtualMachine<> vm;
+  ParallelParser parser(&pool, 1);
+
+  ObjectPtr<> result;
+  parser.parse_all(text.data(), text.size(),
+                   [&vm, &result](const ObjectPtr<>& form) {
+                     result = vm.eval_form(form);
+                   });
+  ASSERT_TRUE(result.valid());
+  EXPECT_EQ("10", result->to_string());
+}
+
+TEST_F(ParallelParserTest, InsideOfPool) {
+  // NOTE: tasks of the pool parse sequentially instead of waiting for it
+  auto result = pool.submit([this](VirtualMachine<>&) {
+    const std::string text = "1 2 3 (4 5)";
+    ParallelParser parser(&pool, 1);
+    return to_strings(parser.parse_all(text.data(), text.size()));
+  });
+  EXPECT_EQ((std::vector<std::string>{"1", "2", "3", "(4 5)"}),
+            result.get());
+}
@@ -15,25 +15,25 @@ public:
   TokensTokenizer(std::initializer_list<Token> tokens) : tokens_(tokens) {}
   ~TokensTokenizer() override {}
 
-  Token current_token() override {
+  const Token& current_token() override {
     if (index_ < 0) {
-      return Token();
+      return undefined_token_;
     } else if (index_ >= static_cast<int>(tokens_.size())) {
-      return Token(TokenType::kEnd);
+      return end_token_;
     }
 
     return tokens_[index_];
   }
 
-  Token peek_token() override {
+  const Token& peek_token() override {
     if (index_ + 1 >= static_cast<int>(tokens_.size())) {
-      return Token(TokenType::kEnd);
+      return end_token_;
     }
 
     return tokens_[index_ + 1];
   }
 
-  Token next_token() override {
+  const Token& next_token() override {
     if (index_ < static_cast<int>(tokens_.size())) {
       ++index_;
     }
@@ -51,6 +51,8 @@ public:
 private:
   std::vector<Token> tokens_;
   int index_ = -1;
+  const Token undefined_token_;
+  const Token end_token_{TokenType::kEnd};
 };
 
 class ParserTest : public ::testing::Test {
@@ -107,6 +109,18 @@ TEST_F(ParserTest, Symbol) {
   EXPECT_EQ(SymbolObject("foo"), *obj);
 }
 
+TEST_F(ParserTest, SymbolsAreInterned) {
+  exec_tokens(
+    Token(TokenType::kSymbol, "foo"),
+    Token(TokenType::kSymbol, "foo")
+  );
+
+  ObjectPtr<Object> first(parser->parse_object());
+  ObjectPtr<Object> second(parser->parse_object());
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(SymbolObject::intern("foo").get(), first.get());
+}
+
 TEST_F(ParserTest, EmptyList) {
   // ()
   exec_tokens(
@@ -417,3 +431,50 @@ TEST_F(ParserTest, MultilineList_Empty) {
   ObjectPtr<Object> obj(parser->parse_object());
   EXPECT_FALSE(obj.valid());
 }
+
+TEST_F(ParserTest, LongList) {
+  const int kLength = 200000;
+  std::string text = "'(";
+  for (int i = 0; i < kLength; ++i) {
+    text += std::to_string(i) + " ";
+  }
+  exec_string(text + ". end) 42");
+
+  ObjectPtr<> obj(parser->parse_object());
+  ASSERT_TRUE(obj.valid() && obj->as_quote());
+  ObjectPtr<> item = obj->as_quote()->get_value();
+  for (int i = 0; i < kLength; ++i) {
+    ASSERT_TRUE(item.valid() && item->as_cons());
+    EXPECT_EQ(NumberObject(i), *item->as_cons()->get_left_value());
+    item = item->as_cons()->get_right_value();
+  }
+  EXPECT_EQ(SymbolObject::intern("end").get(), item.get());
+
+  EXPECT_EQ(NumberObject(42), *parser->parse_object());
+}
+
+TEST_F(ParserTest, DeepList) {
+  const int kDepth = 200000;
+  exec_string(std::string(kDepth, '(') + "'`,1" + std::string(kDepth, ')'));
+
+  ObjectPtr<> obj(parser->parse_object());
+  for (int i = 0; i < kDepth; ++i) {
+    ASSERT_TRUE(obj.valid() && obj->as_cons());
+    EXPECT_FALSE(obj->as_cons()->get_right_value().valid());
+    obj = obj->as_cons()->get_left_value();
+  }
+  ASSERT_TRUE(obj.valid() && obj->as_quote());
+  obj = obj->as_quote()->get_value();
+  ASSERT_TRUE(obj.valid() && obj->as_back_tick());
+  obj = obj->as_back_tick()->get_value();
+  ASSERT_TRUE(obj.valid() && obj->as_comma());
+  EXPECT_EQ(NumberObject(1), *obj->as_comma()->get_value());
+}
+
+TEST_F(ParserTest, UnclosedList) {
+  exec_string("(1 (2 3)");
+  EXPECT_THROW(parser->parse_object(), ParserError);
+
+  exec_string("(1 . 2 3)");
+  EXPECT_THROW(parser->parse_object(), ParserError);
+}
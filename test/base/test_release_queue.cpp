@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <lispp/cons_object.h>
+#include <lispp/number_object.h>
+#include <lispp/release_queue.h>
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+namespace {
+
+  ObjectPtr<> make_list(std::size_t size) {
+    ObjectPtr<> result;
+    for (std::size_t index = 0; index < size; ++index) {
+      result = new ConsObject(NumberObject::make(-1.5), result);
+    }
+    return result;
+  }
+
+  ObjectPtr<> make_nested_list(std::size_t depth) {
+    ObjectPtr<> result;
+    for (std::size_t index = 0; index < depth; ++index) {
+      result = new ConsObject(result);
+    }
+    return result;
+  }
+
+} // namespace
+
+TEST(ReleaseQueueTest, LongList) {
+  auto list = make_list(1000000);
+  list.reset();
+  EXPECT_EQ(0u, ReleaseQueue::get_pending_count());
+}
+
+TEST(ReleaseQueueTest, DeepStructure) {
+  auto list = make_nested_list(1000000);
+  list.reset();
+  EXPECT_EQ(0u, ReleaseQueue::get_pending_count());
+}
+
+TEST(ReleaseQueueTest, Budget) {
+  ReleaseQueue::set_budget(10);
+  auto list = make_list(100);
+  list.reset();
+  // NOTE: the rest of the list is owned by the pending cons
+  EXPECT_EQ(1u, ReleaseQueue::get_pending_count());
+
+  make_list(1).reset();
+  EXPECT_EQ(1u, ReleaseQueue::get_pending_count());
+
+  ReleaseQueue::set_budget(ReleaseQueue::kUnlimitedBudget);
+  EXPECT_EQ(2u, ReleaseQueue::drain(2));
+  // NOTE: each cons owns a number, 20 of 202 objects are deleted by the
+  //       budgeted releases
+  EXPECT_EQ(180u, ReleaseQueue::drain());
+  EXPECT_EQ(0u, ReleaseQueue::get_pending_count());
+}
+
+TEST(ReleaseQueueTest, LongListInVirtualMachine) {
+  VirtualMachine<> vm;
+  vm.eval("(define (build n acc) (if (= n 0) acc (build (- n 1) (cons n acc))))");
+  vm.eval("(define l (build 100000 '()))");
+  EXPECT_EQ("100000", vm.eval("(length l)")->to_string());
+  vm.eval("(set! l '())");
+  EXPECT_EQ(0u, ReleaseQueue::get_pending_count());
+}
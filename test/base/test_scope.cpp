@@ -2,6 +2,7 @@
 
 #include <lispp/scope.h>
 #include <lispp/number_object.h>
+#include <lispp/virtual_machine.h>
 
 using namespace lispp;
 
@@ -12,7 +13,7 @@ public:
   }
 
 protected:
-  std::shared_ptr<Scope> scope;
+  ScopePtr scope;
 };
 
 TEST_F(ScopeTest, HasParentScope) {
@@ -83,8 +84,8 @@ public:
   }
 
 protected:
-  std::shared_ptr<Scope> parent_scope;
-  std::shared_ptr<Scope> scope;
+  ScopePtr parent_scope;
+  ScopePtr scope;
 };
 
 TEST_F(NestedScopeTest, HasParentScope) {
@@ -143,3 +144,73 @@ TEST_F(NestedScopeTest, ReplaceValue_Current) {
   EXPECT_EQ(object1, parent_scope->get_value("foo"));
   EXPECT_EQ(object3, scope->get_value("foo"));
 }
+
+TEST(FrameTest, Slots) {
+  ScopePtr parent_scope(new Scope);
+  auto slot_names = intern_slot_names({SymbolTable::intern("x"),
+                                       SymbolTable::intern("y")});
+  EXPECT_EQ(slot_names, intern_slot_names({SymbolTable::intern("x"),
+                                           SymbolTable::intern("y")}));
+
+  auto frame = Scope::create_frame(parent_scope, slot_names.get());
+  ObjectPtr<> object(new NumberObject(1));
+  frame->set_slot(1, object);
+
+  EXPECT_EQ(1, frame->get_ref_count());
+  EXPECT_EQ(2, parent_scope->get_ref_count());
+  EXPECT_EQ(object, frame->get_value("y"));
+  EXPECT_FALSE(frame->get_value("x").valid());
+
+  frame->set_value("z", object);
+  EXPECT_EQ(3, object->get_ref_count());
+  EXPECT_FALSE(parent_scope->has_value("z"));
+
+  frame.reset();
+  EXPECT_EQ(1, object->get_ref_count());
+  EXPECT_EQ(1, parent_scope->get_ref_count());
+}
+
+TEST(FrameTest, LongChain) {
+  ScopePtr scope(new Scope);
+  for (int depth = 0; depth < 1000000; ++depth) {
+    scope = scope->create_child_scope();
+  }
+  EXPECT_NO_THROW(scope.reset());
+}
+
+TEST(FrozenScopeTest, CopyOnWrite) {
+  ScopePtr base(new Scope);
+  ObjectPtr<> object(new NumberObject(1));
+  base->set_value("x", object);
+  base->freeze();
+  EXPECT_TRUE(object->is_immortal());
+
+  auto first = base->create_child_scope();
+  auto second = base->create_child_scope();
+  EXPECT_EQ(1, base->get_ref_count());
+
+  ObjectPtr<> other(new NumberObject(2));
+  first->create_child_scope()->replace_value("x", other);
+  EXPECT_EQ(other, first->get_value("x"));
+  EXPECT_EQ(object, second->get_value("x"));
+  EXPECT_EQ(object, base->get_value("x"));
+
+  EXPECT_THROW(base->set_value("y", other), ScopeError);
+  EXPECT_THROW(base->replace_value("x", other), ScopeError);
+  EXPECT_THROW(second->replace_value("y", other), ScopeError);
+}
+
+TEST(FrozenScopeTest, VirtualMachines) {
+  VirtualMachine<> first;
+  VirtualMachine<> second;
+  EXPECT_EQ(first.get_global_scope()->get_parent_scope(),
+            second.get_global_scope()->get_parent_scope());
+
+  first.eval("(define (abs x) 42)");
+  first.eval("(set! car cdr)");
+  EXPECT_EQ("42", first.eval("(abs -1)")->to_string());
+  EXPECT_EQ("(2)", first.eval("(car '(1 2))")->to_string());
+
+  EXPECT_EQ("1", second.eval("(abs -1)")->to_string());
+  EXPECT_EQ("1", second.eval("(car '(1 2))")->to_string());
+}
@@ -0,0 +1,77 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include <lispp/file_tokenizer.h>
+#include <lispp/parser.h>
+#include <lispp/stdlib_image.h>
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+namespace lispp {
+namespace builtins {
+
+extern const StdlibImage kBuiltinsStdlib_common;
+extern const StdlibImage kBuiltinsStdlib_list;
+
+} // builtins
+} // lispp
+
+namespace {
+
+  // NOTE: the image must hold the forms the parser reads from the module
+  void check_module(const StdlibImage& image, const std::string& module_name) {
+    FileTokenizer tokenizer(std::string(LISPP_STDLIB_SOURCES_PATH) + "/" +
+                            module_name + ".lisp");
+    Parser parser(&tokenizer);
+    const auto forms = load_stdlib_image(image);
+
+    std::size_t forms_count = 0;
+    while (parser.has_objects()) {
+      const ObjectPtr<> form = parser.parse_object();
+      ASSERT_LT(forms_count, forms.size()) << form->to_string();
+      EXPECT_TRUE(form.safe_equal(forms[forms_count]))
+          << form->to_string() << " != " << forms[forms_count]->to_string();
+      ++forms_count;
+    }
+    EXPECT_EQ(forms.size(), forms_count);
+  }
+
+} // namespace
+
+TEST(StdlibImageTest, Load) {
+  // NOTE: (f '(1 . "a") #t) x
+  const ImageNode nodes[] = {
+    {ImageNodeType::kSymbol, 0, "f"},
+    {ImageNodeType::kNumber, 1, nullptr},
+    {ImageNodeType::kCharacters, 0, "a"},
+    {ImageNodeType::kCons, 0, nullptr},
+    {ImageNodeType::kQuote, 0, nullptr},
+    {ImageNodeType::kTrue, 0, nullptr},
+    {ImageNodeType::kNil, 0, nullptr},
+    {ImageNodeType::kCons, 0, nullptr},
+    {ImageNodeType::kCons, 0, nullptr},
+    {ImageNodeType::kCons, 0, nullptr},
+    {ImageNodeType::kSymbol, 0, "x"}
+  };
+
+  auto forms = load_stdlib_image(
+      StdlibImage{nodes, sizeof(nodes) / sizeof(nodes[0])});
+  ASSERT_EQ(2u, forms.size());
+
+  VirtualMachine<> vm;
+  EXPECT_TRUE(forms[0]->operator==(*vm.parse("(f '(1 . \"a\") #t)")));
+  EXPECT_TRUE(forms[0]->is_immortal());
+  EXPECT_EQ("x", forms[1]->to_string());
+}
+
+TEST(StdlibImageTest, ModulesMatchParser) {
+  check_module(builtins::kBuiltinsStdlib_common, "common");
+  check_module(builtins::kBuiltinsStdlib_list, "list");
+}
+
+TEST(StdlibImageTest, Stdlib) {
+  VirtualMachine<> vm;
+  auto result = vm.eval("(list (list-ref '(1 2 3) 1) (max 1 3 2) (abs -4))");
+  EXPECT_EQ("(2 3 4)", result->to_string());
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include <lispp/symbol_object.h>
+#include <lispp/symbol_table.h>
+
+using namespace lispp;
+
+TEST(SymbolTableTest, Intern) {
+  const SymbolId foo = SymbolTable::intern("foo");
+  EXPECT_EQ(foo, SymbolTable::intern("foo"));
+  EXPECT_NE(foo, SymbolTable::intern("bar"));
+  EXPECT_EQ("foo", SymbolTable::get_name(foo));
+}
+
+TEST(SymbolTableTest, CanonicalSymbol) {
+  auto symbol = SymbolObject::intern("foo");
+  EXPECT_EQ(symbol, SymbolObject::intern("foo"));
+  EXPECT_EQ(SymbolTable::intern("foo"), symbol->get_id());
+  EXPECT_EQ(SymbolObject("foo"), *symbol);
+  EXPECT_FALSE(SymbolObject("bar") == *symbol);
+}
+
+TEST(SymbolTableTest, InternText) {
+  // NOTE: the text isn't terminated after the name
+  const std::string text = "a-long-symbol-name-out-of-small-strings tail";
+  auto symbol = SymbolObject::intern(text.data(), 39);
+  EXPECT_EQ("a-long-symbol-name-out-of-small-strings", symbol->get_value());
+  EXPECT_EQ(symbol, SymbolObject::intern(symbol->get_value()));
+  EXPECT_EQ(symbol, SymbolObject::intern(text.data(), 39));
+  EXPECT_NE(symbol, SymbolObject::intern(text.data(), 38));
+}
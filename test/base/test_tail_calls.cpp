@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <lispp/virtual_machine.h>
+
+using namespace lispp;
+
+// NOTE: evaluates forms by tree-walking eval (without bytecode compiler)
+class TailCallsTest : public ::testing::Test {
+protected:
+  std::string eval(const std::string& code) {
+    auto result = vm.parse(code).safe_eval(vm.get_global_scope());
+    return (result.valid() ? result->to_string() : "()");
+  }
+
+  VirtualMachine<> vm;
+};
+
+TEST_F(TailCallsTest, SlowAdd) {
+  eval("(define slow-add (lambda (x y) "
+       "  (if (= x 0) y (slow-add (- x 1) (+ y 1)))))");
+  EXPECT_EQ("6", eval("(slow-add 3 3)"));
+  EXPECT_EQ("300000", eval("(slow-add 300000 0)"));
+}
+
+TEST_F(TailCallsTest, Cond) {
+  eval("(define (f n) (cond ((= n 0) 'done) (#t (f (- n 1)))))");
+  EXPECT_EQ("done", eval("(f 300000)"));
+}
+
+TEST_F(TailCallsTest, Let) {
+  eval("(define (f n) (let ((m (- n 1))) (if (< m 0) 'done (f m))))");
+  EXPECT_EQ("done", eval("(f 300000)"));
+}
+
+TEST_F(TailCallsTest, AndOr) {
+  eval("(define (f n) (or (= n 0) (and #t (f (- n 1)))))");
+  EXPECT_EQ("#t", eval("(f 300000)"));
+  EXPECT_EQ("#f", eval("(and 1 #f (f 1))"));
+  EXPECT_EQ("1", eval("(or #f 1 (f 1))"));
+}
+
+TEST_F(TailCallsTest, MutualRecursion) {
+  eval("(define (even? n) (if (= n 0) #t (odd? (- n 1))))");
+  eval("(define (odd? n) (if (= n 0) #f (even? (- n 1))))");
+  EXPECT_EQ("#t", eval("(even? 300000)"));
+}
+
+TEST_F(TailCallsTest, MacroExpansion) {
+  eval("(define-macro (my-if c a b) (list 'cond (list c a) (list #t b)))");
+  eval("(define (f n) (my-if (= n 0) 'done (f (- n 1))))");
+  EXPECT_EQ("done", eval("(f 100000)"));
+}
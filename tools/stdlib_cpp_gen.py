@@ -2,15 +2,145 @@
 
 from __future__ import print_function
 import argparse
+import string
+
+# NOTE: Mirrors the lexemes of BufferTokenizer (see lispp/char_classes.h):
+#       tokens it rejects are rejected here too. The StdlibImage test checks
+#       the generated images against the forms of the C++ parser
+WHITE_SPACES = " \t\v\f\r\n"
+SIGNS = "+-"
+DIGITS_EXT = "0123456789" + SIGNS + "."
+INITIALS_OF_SYMBOL = string.ascii_letters + "!$%&*/:<=>?~_^#"
+SYMBOL_CHARS = INITIALS_OF_SYMBOL + DIGITS_EXT
+ONE_CHAR_TOKENS = "()'`,."
+
+
+def skip_chars(text, position, chars):
+    while position < len(text) and text[position] in chars:
+        position += 1
+    return position
+
+
+# NOTE: numbers are returned as floats, other tokens as their text
+def tokenize(text):
+    tokens = []
+    position = skip_chars(text, 0, WHITE_SPACES)
+    while position < len(text):
+        begin = position
+        value = None
+        char = text[position]
+        next_char = text[position + 1] if position + 1 < len(text) else " "
+        if char == '"':
+            position = text.find('"', position + 1) + 1
+            if position == 0:
+                raise ValueError("Unexpected end of file on reading string")
+        elif char in INITIALS_OF_SYMBOL or (char in SIGNS and
+                                            next_char not in DIGITS_EXT):
+            position = skip_chars(text, position, SYMBOL_CHARS)
+            if char in SIGNS and position - begin != 1:
+                raise ValueError("Invalid identifier token '{}'".format(
+                    text[begin:position]))
+        elif char in DIGITS_EXT:
+            position = skip_chars(text, position, DIGITS_EXT)
+            token = text[begin:position]
+            if (any(sign in token[1:] for sign in SIGNS) or
+                    token.count(".") > 1):
+                raise ValueError("Invalid number token '{}'".format(token))
+            if token != ".":
+                value = float(token)
+        elif char in ONE_CHAR_TOKENS:
+            position += 1
+        else:
+            raise ValueError("Unexpected symbol '{}' at {}".format(char,
+                                                                  position))
+
+        tokens.append(value if value is not None else text[begin:position])
+        position = skip_chars(text, position, WHITE_SPACES)
+    return tokens
+
+
+def c_string(value):
+    return '"{}"'.format(value.replace('\\', '\\\\').replace('"', '\\"')
+                              .replace('\n', '\\n'))
+
+
+def node(node_type, number_value=0, string_value=None):
+    return "{{ImageNodeType::k{}, {}, {}}}".format(
+        node_type, repr(float(number_value)),
+        c_string(string_value) if string_value is not None else "nullptr")
+
+
+class ImageBuilder(object):
+    """Emits the forms as postfix sequence of nodes (see stdlib_image.h)"""
+
+    PREFIXES = {"'": "Quote", ",": "Comma", "`": "BackTick"}
+
+    def __init__(self, tokens):
+        self.tokens = tokens
+        self.position = 0
+        self.nodes = []
+
+    def build(self):
+        while self.position < len(self.tokens):
+            self.parse_object()
+        return self.nodes
+
+    def next_token(self):
+        if self.position >= len(self.tokens):
+            raise ValueError("Unexpected end of file")
+        token = self.tokens[self.position]
+        self.position += 1
+        return token
+
+    def peek_token(self):
+        if self.position >= len(self.tokens):
+            raise ValueError("Unexpected end of file")
+        return self.tokens[self.position]
+
+    def parse_object(self):
+        token = self.next_token()
+        if isinstance(token, float):
+            self.nodes.append(node("Number", number_value=token))
+        elif token == "(":
+            self.parse_begun_list()
+        elif token in self.PREFIXES:
+            self.parse_object()
+            self.nodes.append(node(self.PREFIXES[token]))
+        elif token == ")" or token == ".":
+            raise ValueError("Unexpected token '{}'".format(token))
+        elif token.startswith('"'):
+            self.nodes.append(node("Characters", string_value=token[1:-1]))
+        elif token == "#t":
+            self.nodes.append(node("True"))
+        elif token == "#f":
+            self.nodes.append(node("False"))
+        else:
+            self.nodes.append(node("Symbol", string_value=token))
+
+    def parse_begun_list(self):
+        items_count = 0
+        while self.peek_token() not in (")", "."):
+            self.parse_object()
+            items_count += 1
+
+        if self.next_token() == ".":
+            if items_count == 0:
+                raise ValueError("Unexpected token '.'")
+            self.parse_object()
+            if self.next_token() != ")":
+                raise ValueError("Expected ')' after dotted tail")
+        else:
+            self.nodes.append(node("Nil"))
+
+        self.nodes.extend([node("Cons")] * items_count)
+
 
 def main(args):
-    template_text = args.template_file.read();
-    module_text = ""
-    for line in args.module_file:
-        module_text += '    "{}"\n'.format(line.rstrip().replace('"', '\\"'))
+    template_text = args.template_file.read()
+    nodes = ImageBuilder(tokenize(args.module_file.read())).build()
 
     result_text = template_text.format(module_name=args.module_name,
-                                       module_text=module_text.strip())
+                                       nodes=",\n    ".join(nodes))
     print(result_text, file=args.output_file)
 
 if __name__ == "__main__":